@@ -0,0 +1,159 @@
+// Copyright TinyAlmonds (Alex Noerdemann)
+
+#include "Core/AbilitySystem/PLAbilitySet.h"
+
+#include "Abilities/GameplayAbility.h"
+#include "AbilitySystemComponent.h"
+#include "Engine/AssetManager.h"
+#include "GameplayEffect.h"
+#include "HAL/PlatformTime.h"
+
+#include "Core/Benchmark/PLMemoryTags.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogPLAbilitySet, Log, All);
+
+void UPLAbilitySet::GiveToAbilitySystem(UAbilitySystemComponent &AbilitySystemComponent, UObject *SourceObject, TArray<FGameplayAbilitySpecHandle> &OutPassiveAbilitySpecHandles) const
+{
+	LoadSynchronous();
+
+	// the loaded assets are tracked by their own tags, the given specs and effects by the AbilitySystem tag
+	LLM_SCOPE_BYTAG(ProjectLux_AbilitySystem);
+	for (const TSoftClassPtr<UGameplayAbility> &Ability : Abilities)
+	{
+		if (const TSubclassOf<UGameplayAbility> AbilityClass{Ability.Get()}; AbilityClass)
+		{
+			AbilitySystemComponent.GiveAbility(FGameplayAbilitySpec(AbilityClass, 1, -1, SourceObject));
+		}
+	}
+
+	for (const TSoftClassPtr<UGameplayAbility> &PassiveAbility : PassiveAbilities)
+	{
+		if (const TSubclassOf<UGameplayAbility> PassiveAbilityClass{PassiveAbility.Get()}; PassiveAbilityClass)
+		{
+			const FGameplayAbilitySpecHandle PassiveAbilitySpecHandle{AbilitySystemComponent.GiveAbility(FGameplayAbilitySpec(PassiveAbilityClass, 1, -1, SourceObject))};
+			AbilitySystemComponent.TryActivateAbility(PassiveAbilitySpecHandle);
+			OutPassiveAbilitySpecHandles.Add(PassiveAbilitySpecHandle);
+		}
+	}
+
+	// initialize the AttributeSets by instant GameplayEffects (which do exactly this)
+	for (const TSoftClassPtr<UGameplayEffect> &AttributeSetInitEffect : AttributeSetInitEffects)
+	{
+		if (const TSubclassOf<UGameplayEffect> AttributeSetInitEffectClass{AttributeSetInitEffect.Get()}; AttributeSetInitEffectClass)
+		{
+			FGameplayEffectContextHandle EffectContext = AbilitySystemComponent.MakeEffectContext();
+			EffectContext.AddSourceObject(SourceObject);
+			AbilitySystemComponent.ApplyGameplayEffectToSelf(AttributeSetInitEffectClass.GetDefaultObject(), 1.0f, EffectContext);
+		}
+	}
+}
+
+void UPLAbilitySet::GetSoftObjectPaths(TArray<FSoftObjectPath> &OutPaths) const
+{
+	for (const TSoftClassPtr<UGameplayAbility> &Ability : Abilities)
+	{
+		OutPaths.Add(Ability.ToSoftObjectPath());
+	}
+	for (const TSoftClassPtr<UGameplayAbility> &PassiveAbility : PassiveAbilities)
+	{
+		OutPaths.Add(PassiveAbility.ToSoftObjectPath());
+	}
+	for (const TSoftClassPtr<UGameplayEffect> &AttributeSetInitEffect : AttributeSetInitEffects)
+	{
+		OutPaths.Add(AttributeSetInitEffect.ToSoftObjectPath());
+	}
+}
+
+bool UPLAbilitySet::IsLoaded() const
+{
+	TArray<FSoftObjectPath> Paths{};
+	GetSoftObjectPaths(Paths);
+
+	return !Paths.ContainsByPredicate([](const FSoftObjectPath &Path)
+									  { return !Path.IsNull() && !Path.ResolveObject(); });
+}
+
+TSharedPtr<FStreamableHandle> UPLAbilitySet::LoadAbilitySetsAsync(const TArray<UPLAbilitySet *> &AbilitySets, FStreamableDelegate OnLoaded)
+{
+	TArray<FSoftObjectPath> Paths{};
+	FString DebugName{TEXT("PLAbilitySets")};
+	for (const UPLAbilitySet *AbilitySet : AbilitySets)
+	{
+		if (AbilitySet)
+		{
+			AbilitySet->GetSoftObjectPaths(Paths);
+			DebugName += TEXT(" ") + AbilitySet->GetName();
+		}
+	}
+	Paths.RemoveAll([](const FSoftObjectPath &Path)
+					{ return Path.IsNull(); });
+
+	if (Paths.IsEmpty())
+	{
+		OnLoaded.ExecuteIfBound();
+		return nullptr;
+	}
+
+	// the load time is measured from the request to the completion on the game thread
+	const double RequestTime{FPlatformTime::Seconds()};
+	const int32 NumPaths{Paths.Num()};
+	return UAssetManager::GetStreamableManager().RequestAsyncLoad(
+		MoveTemp(Paths), [OnLoaded, RequestTime, NumPaths, DebugName]()
+		{
+			UE_LOG(LogPLAbilitySet, Log, TEXT("Loaded %d classes of %s asynchronously in %.2f ms."), NumPaths, *DebugName, (FPlatformTime::Seconds() - RequestTime) * 1000.0);
+			OnLoaded.ExecuteIfBound(); },
+		FStreamableManager::AsyncLoadHighPriority, false, false, DebugName);
+}
+
+UPLAbilitySet *UPLAbilitySet::CreateFromDeprecatedProperties(UObject &Owner, const TArray<TSubclassOf<UGameplayAbility>> &DeprecatedAbilities, const TArray<TSubclassOf<UGameplayAbility>> &DeprecatedPassiveAbilities,
+															 const TArray<TSubclassOf<UGameplayEffect>> &DeprecatedAttributeSetInitEffects)
+{
+	const bool bHasAttributeSetInitEffects{DeprecatedAttributeSetInitEffects.ContainsByPredicate([](const TSubclassOf<UGameplayEffect> &Effect)
+																								 { return Effect != nullptr; })};
+	if (DeprecatedAbilities.IsEmpty() && DeprecatedPassiveAbilities.IsEmpty() && !bHasAttributeSetInitEffects)
+	{
+		return nullptr;
+	}
+
+	UPLAbilitySet *AbilitySet = NewObject<UPLAbilitySet>(&Owner, MakeUniqueObjectName(&Owner, StaticClass(), TEXT("MigratedAbilitySet")));
+	for (const TSubclassOf<UGameplayAbility> &Ability : DeprecatedAbilities)
+	{
+		AbilitySet->Abilities.Add(Ability.Get());
+	}
+	for (const TSubclassOf<UGameplayAbility> &PassiveAbility : DeprecatedPassiveAbilities)
+	{
+		AbilitySet->PassiveAbilities.Add(PassiveAbility.Get());
+	}
+	for (const TSubclassOf<UGameplayEffect> &AttributeSetInitEffect : DeprecatedAttributeSetInitEffects)
+	{
+		if (AttributeSetInitEffect)
+		{
+			AbilitySet->AttributeSetInitEffects.Add(AttributeSetInitEffect.Get());
+		}
+	}
+
+	UE_LOG(LogPLAbilitySet, Log, TEXT("Migrated the deprecated abilities and initialization effects of %s into %s. Resave the asset to keep the migration."), *Owner.GetPathName(), *AbilitySet->GetName());
+	return AbilitySet;
+}
+
+void UPLAbilitySet::LoadSynchronous() const
+{
+	TArray<FSoftObjectPath> Paths{};
+	GetSoftObjectPaths(Paths);
+	Paths.RemoveAll([](const FSoftObjectPath &Path)
+					{ return Path.IsNull() || Path.ResolveObject(); });
+
+	if (Paths.IsEmpty())
+	{
+		return;
+	}
+
+	const double StartTime{FPlatformTime::Seconds()};
+	for (const FSoftObjectPath &Path : Paths)
+	{
+		Path.TryLoad();
+	}
+
+	// every blocking load is a missing preload, e.g. the set is not preloaded by the GameMode
+	UE_LOG(LogPLAbilitySet, Warning, TEXT("Loaded %d classes of %s blocking in %.2f ms. Preload the set to avoid the hitch."), Paths.Num(), *GetName(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
@@ -2,77 +2,400 @@
 
 #include "Core/AbilitySystem/PLAbilitySystemComponent.h"
 
+#include "Abilities/GameplayAbility.h"
+#include "Engine/World.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "TimerManager.h"
+
+#include "Core/Benchmark/PLMemoryTags.h"
+#include "Core/Subsystem/PLHitchDetectorSubsystem.h"
+
+namespace
+{
+	TAutoConsoleVariable<bool> CVarPLActivationCache{TEXT("projectlux.FastPath.ActivationCache"), true, TEXT("Whether the results of the activation checks are memoized per frame, until the state of the ASC changes. Every check runs in full, if disabled."), ECVF_Cheat};
+}
+
 bool UPLAbilitySystemComponent::CanActivateAbilityOfClass(const TSubclassOf<UGameplayAbility> &InAbilityToCheck)
 {
-	const UGameplayAbility *const InAbilityCDO = InAbilityToCheck.GetDefaultObject();
+	const FGameplayAbilitySpec *const Spec = FindAbilitySpecFromClassCached(InAbilityToCheck);
+
+	return Spec ? CanActivateAbilityCached(*Spec) : false;
+}
+
+UGameplayAbility *UPLAbilitySystemComponent::ActivateAbilityOfClass(const TSubclassOf<UGameplayAbility> &InAbilityToActivate, bool &OutIsInstance)
+{
+	PL_SCOPE_HITCH_STAGE(AbilityActivation);
+
+	OutIsInstance = false;
 
-	for (const FGameplayAbilitySpec &ActivatableSpec : ActivatableAbilities.Items)
+	const FGameplayAbilitySpec *Spec = FindAbilitySpecFromClassCached(InAbilityToActivate);
+	if (!Spec || !TryActivateAbility(Spec->Handle))
 	{
-		if (ActivatableSpec.Ability == InAbilityCDO)
+		return nullptr;
+	}
+
+	// the activation can give or remove abilities, which invalidates the spec pointer
+	Spec = FindAbilitySpecFromClassCached(InAbilityToActivate);
+	if (!Spec)
+	{
+		return nullptr;
+	}
+
+	// try to get the ability instance
+	// Note: we need a instanced ability to be able to bind to its "Event Dispatchers"
+	UGameplayAbility *AbilityInstance = Spec->GetPrimaryInstance();
+
+	if (AbilityInstance)
+	{
+		OutIsInstance = true;
+		return AbilityInstance;
+	}
+	else
+	{
+		// default to the CDO if we can't
+		return Spec->Ability;
+	}
+}
+
+FGameplayAbilitySpec *UPLAbilitySystemComponent::FindAbilitySpecFromClassCached(const TSubclassOf<UGameplayAbility> &AbilityClass)
+{
+	FPLAbilitySpecIndexEntry *const Entry = AbilitySpecIndex.Find(TObjectKey<UClass>{AbilityClass.Get()});
+	if (!Entry)
+	{
+		return nullptr;
+	}
+
+	// the item index is only a hint, since removing a spec shifts or swaps the items
+	if (ActivatableAbilities.Items.IsValidIndex(Entry->ItemIndex) && (ActivatableAbilities.Items[Entry->ItemIndex].Handle == Entry->Handle))
+	{
+		return &ActivatableAbilities.Items[Entry->ItemIndex];
+	}
+
+	Entry->ItemIndex = ActivatableAbilities.Items.IndexOfByPredicate([Handle = Entry->Handle](const FGameplayAbilitySpec &ActivatableSpec)
+																	 { return ActivatableSpec.Handle == Handle; });
+
+	return (Entry->ItemIndex != INDEX_NONE) ? &ActivatableAbilities.Items[Entry->ItemIndex] : nullptr;
+}
+
+bool UPLAbilitySystemComponent::CanActivateAbilityCached(const FGameplayAbilitySpec &AbilitySpec)
+{
+	bool bCanActivate{false};
+	if (FindActivationCacheResult(AbilitySpec, bCanActivate))
+	{
+		return bCanActivate;
+	}
+
+	const UGameplayAbility *const Ability = AbilitySpec.Ability;
+	const FGameplayAbilityActorInfo *const ActorInfo = AbilityActorInfo.Get();
+	if (!AbilitySpec.PendingRemove && !AbilitySpec.RemoveAfterActivation && Ability && ActorInfo && ActorInfo->OwnerActor.IsValid() && ActorInfo->AvatarActor.IsValid())
+	{
+		// like the activation, instanced abilities are checked by their instance (e.g. for the Blueprint CanActivate overrides)
+		const UGameplayAbility *const PrimaryInstance = AbilitySpec.GetPrimaryInstance();
+		const UGameplayAbility *const CanActivateAbilitySource = PrimaryInstance ? PrimaryInstance : Ability;
+
+		FGameplayTagContainer FailureTags;
+		bCanActivate = CanActivateAbilitySource->CanActivateAbility(AbilitySpec.Handle, ActorInfo, nullptr, nullptr, &FailureTags);
+	}
+
+	SetActivationCacheResult(AbilitySpec.Handle, bCanActivate);
+	return bCanActivate;
+}
+
+bool UPLAbilitySystemComponent::TryActivateAbilitiesByTagCached(const FGameplayTagContainer &GameplayTagContainer)
+{
+	PL_SCOPE_HITCH_STAGE(AbilityActivation);
+
+	TArray<FGameplayAbilitySpec *> MatchingAbilitySpecs{};
+	GetActivatableGameplayAbilitySpecsByAllMatchingTags(GameplayTagContainer, MatchingAbilitySpecs);
+
+	// copy the handles, since activations can reallocate the specs
+	// only memoized negative results are skipped, the activation checks all other abilities itself (so a successful activation is checked once)
+	TArray<FGameplayAbilitySpecHandle, TInlineAllocator<4>> AbilitySpecHandlesToActivate{};
+	for (const FGameplayAbilitySpec *AbilitySpec : MatchingAbilitySpecs)
+	{
+		bool bCanActivate{false};
+		if (!FindActivationCacheResult(*AbilitySpec, bCanActivate) || bCanActivate)
 		{
-			const FGameplayAbilitySpec *const Spec = FindAbilitySpecFromHandle(ActivatableSpec.Handle);
-			if (!Spec)
-			{
-				return false;
-			}
-			if (Spec->PendingRemove || Spec->RemoveAfterActivation)
-			{
-				return false;
-			}
+			AbilitySpecHandlesToActivate.Add(AbilitySpec->Handle);
+		}
+	}
+
+	bool bSuccess{false};
+	for (const FGameplayAbilitySpecHandle &AbilitySpecHandle : AbilitySpecHandlesToActivate)
+	{
+		if (TryActivateAbility(AbilitySpecHandle))
+		{
+			bSuccess = true;
+		}
+		else
+		{
+			// repeated inputs of the frame skip the failed ability, until the state of the ASC changes (state outside of the ASC is reevaluated in the next frame)
+			SetActivationCacheResult(AbilitySpecHandle, false);
+		}
+	}
+
+	return bSuccess;
+}
+
+void UPLAbilitySystemComponent::InvalidateActivationCache()
+{
+	++ActivationCacheGeneration;
+}
+
+void UPLAbilitySystemComponent::StartAbilityCooldown(FGameplayTag CooldownTag, float Duration)
+{
+	const UWorld *World = GetWorld();
+	if (!World || !CooldownTag.IsValid() || (Duration <= 0.0f))
+	{
+		return;
+	}
+
+	FPLAbilityBlock Block{};
+	Block.Tag = CooldownTag;
+	Block.EndTime = World->GetTimeSeconds() + Duration;
+	AddAbilityBlock(Block);
+
+	UpdateAbilityCooldowns();
+}
+
+void UPLAbilitySystemComponent::BlockAbilityUntilGrounded(FGameplayTag BlockTag)
+{
+	// on the ground the block would last until the next landing after a jump
+	const UCharacterMovementComponent *CharacterMovementComponent = AbilityActorInfo.IsValid() ? Cast<UCharacterMovementComponent>(AbilityActorInfo->MovementComponent.Get()) : nullptr;
+	if (!BlockTag.IsValid() || !CharacterMovementComponent || !CharacterMovementComponent->IsFalling())
+	{
+		return;
+	}
+
+	FPLAbilityBlock Block{};
+	Block.Tag = BlockTag;
+	Block.bUntilGrounded = true;
+	AddAbilityBlock(Block);
+}
+
+float UPLAbilitySystemComponent::GetAbilityCooldownTimeRemaining(FGameplayTag CooldownTag) const
+{
+	const UWorld *World = GetWorld();
+	const FPLAbilityBlock *Block = AbilityBlocks.FindByPredicate([&CooldownTag](const FPLAbilityBlock &AbilityBlock)
+																 { return !AbilityBlock.bUntilGrounded && (AbilityBlock.Tag == CooldownTag); });
+
+	return (World && Block) ? FMath::Max(static_cast<float>(Block->EndTime - World->GetTimeSeconds()), 0.0f) : 0.0f;
+}
+
+void UPLAbilitySystemComponent::NotifyLanded()
+{
+	RemoveAbilityBlocks([](const FPLAbilityBlock &Block)
+						{ return Block.bUntilGrounded; });
+}
+
+void UPLAbilitySystemComponent::ClearAbilityBlocks()
+{
+	RemoveAbilityBlocks([](const FPLAbilityBlock &)
+						{ return true; });
+
+	if (const UWorld *World = GetWorld(); World)
+	{
+		World->GetTimerManager().ClearTimer(AbilityCooldownTimerHandle);
+	}
+}
+
+void UPLAbilitySystemComponent::InitAbilityActorInfo(AActor *InOwnerActor, AActor *InAvatarActor)
+{
+	Super::InitAbilityActorInfo(InOwnerActor, InAvatarActor);
+
+	InvalidateActivationCache();
+
+	// the actor info is initialized on every possession, so a previous binding is removed first
+	FOnGameplayEffectTagCountChanged &BlockedAbilityTagChangeDelegate = BlockedAbilityTags.RegisterGenericGameplayEvent();
+	BlockedAbilityTagChangeDelegate.RemoveAll(this);
+	BlockedAbilityTagChangeDelegate.AddUObject(this, &UPLAbilitySystemComponent::OnBlockedAbilityTagChanged);
 
-			const UGameplayAbility *const Ability = Spec->Ability;
-			if (!Ability)
+	for (const UAttributeSet *AttributeSet : GetSpawnedAttributes())
+	{
+		if (!AttributeSet)
+		{
+			continue;
+		}
+
+		for (TFieldIterator<FProperty> PropertyIt(AttributeSet->GetClass()); PropertyIt; ++PropertyIt)
+		{
+			if (FGameplayAttribute::IsGameplayAttributeDataProperty(*PropertyIt))
 			{
-				return false;
+				// the actor info is initialized on every possession, so previous bindings are removed first
+				FOnGameplayAttributeValueChange &AttributeValueChangeDelegate = GetGameplayAttributeValueChangeDelegate(FGameplayAttribute{*PropertyIt});
+				AttributeValueChangeDelegate.RemoveAll(this);
+				AttributeValueChangeDelegate.AddUObject(this, &UPLAbilitySystemComponent::OnAttributeChangedForActivationCache);
 			}
+		}
+	}
+}
+
+FActiveGameplayEffectHandle UPLAbilitySystemComponent::ApplyGameplayEffectSpecToSelf(const FGameplayEffectSpec &GameplayEffect, FPredictionKey PredictionKey)
+{
+	LLM_SCOPE_BYTAG(ProjectLux_AbilitySystem);
+	return Super::ApplyGameplayEffectSpecToSelf(GameplayEffect, PredictionKey);
+}
+
+SIZE_T UPLAbilitySystemComponent::GetCacheAllocatedSize() const
+{
+	return AbilitySpecIndex.GetAllocatedSize() + ActivationCache.GetAllocatedSize() + AbilityBlocks.GetAllocatedSize();
+}
 
-			const FGameplayAbilityActorInfo *const ActorInfo = AbilityActorInfo.Get();
-			if (ActorInfo == nullptr || !ActorInfo->OwnerActor.IsValid() || !ActorInfo->AvatarActor.IsValid())
+void UPLAbilitySystemComponent::OnGiveAbility(FGameplayAbilitySpec &AbilitySpec)
+{
+	Super::OnGiveAbility(AbilitySpec);
+
+	if (AbilitySpec.Ability && !AbilitySpecIndex.Contains(TObjectKey<UClass>{AbilitySpec.Ability->GetClass()}))
+	{
+		// the given spec is already part of the items
+		LLM_SCOPE_BYTAG(ProjectLux_Caches);
+		FPLAbilitySpecIndexEntry Entry{};
+		Entry.Handle = AbilitySpec.Handle;
+		Entry.ItemIndex = ActivatableAbilities.Items.IndexOfByPredicate([&AbilitySpec](const FGameplayAbilitySpec &ActivatableSpec)
+																		{ return &ActivatableSpec == &AbilitySpec; });
+		AbilitySpecIndex.Add(TObjectKey<UClass>{AbilitySpec.Ability->GetClass()}, Entry);
+	}
+}
+
+void UPLAbilitySystemComponent::OnRemoveAbility(FGameplayAbilitySpec &AbilitySpec)
+{
+	if (AbilitySpec.Ability)
+	{
+		const TObjectKey<UClass> AbilityClassKey{AbilitySpec.Ability->GetClass()};
+		if (const FPLAbilitySpecIndexEntry *Entry = AbilitySpecIndex.Find(AbilityClassKey); Entry && (Entry->Handle == AbilitySpec.Handle))
+		{
+			AbilitySpecIndex.Remove(AbilityClassKey);
+
+			// another spec of the same class takes over (only happens, if a class was given multiple times)
+			const int32 NextItemIndex = ActivatableAbilities.Items.IndexOfByPredicate([&AbilitySpec](const FGameplayAbilitySpec &ActivatableSpec)
+																					   { return (ActivatableSpec.Handle != AbilitySpec.Handle) && ActivatableSpec.Ability && (ActivatableSpec.Ability->GetClass() == AbilitySpec.Ability->GetClass()); });
+			if (NextItemIndex != INDEX_NONE)
 			{
-				return false;
+				FPLAbilitySpecIndexEntry NextEntry{};
+				NextEntry.Handle = ActivatableAbilities.Items[NextItemIndex].Handle;
+				NextEntry.ItemIndex = NextItemIndex;
+				AbilitySpecIndex.Add(AbilityClassKey, NextEntry);
 			}
-
-			FGameplayTagContainer FailureTags;
-			return Ability->CanActivateAbility(ActivatableSpec.Handle, ActorInfo, nullptr, nullptr, &FailureTags);
 		}
 	}
 
-	return false;
+	ActivationCache.Remove(AbilitySpec.Handle);
+
+	Super::OnRemoveAbility(AbilitySpec);
 }
 
-UGameplayAbility *UPLAbilitySystemComponent::ActivateAbilityOfClass(const TSubclassOf<UGameplayAbility> &InAbilityToActivate, bool &OutIsInstance)
+void UPLAbilitySystemComponent::OnTagUpdated(const FGameplayTag &Tag, bool TagExists)
+{
+	Super::OnTagUpdated(Tag, TagExists);
+
+	InvalidateActivationCache();
+}
+
+void UPLAbilitySystemComponent::NotifyAbilityActivated(const FGameplayAbilitySpecHandle Handle, UGameplayAbility *Ability)
+{
+	Super::NotifyAbilityActivated(Handle, Ability);
+
+	InvalidateActivationCache();
+}
+
+void UPLAbilitySystemComponent::NotifyAbilityEnded(FGameplayAbilitySpecHandle Handle, UGameplayAbility *Ability, bool bWasCancelled)
 {
-	if (!TryActivateAbilityByClass(InAbilityToActivate))
+	Super::NotifyAbilityEnded(Handle, Ability, bWasCancelled);
+
+	InvalidateActivationCache();
+}
+
+void UPLAbilitySystemComponent::AddAbilityBlock(const FPLAbilityBlock &Block)
+{
+	if (FPLAbilityBlock *ExistingBlock = AbilityBlocks.FindByPredicate([&Block](const FPLAbilityBlock &AbilityBlock)
+																		{ return (AbilityBlock.Tag == Block.Tag) && (AbilityBlock.bUntilGrounded == Block.bUntilGrounded); });
+		ExistingBlock)
 	{
-		OutIsInstance = false;
-		return nullptr;
+		*ExistingBlock = Block;
+		return;
 	}
 
-	const UGameplayAbility *const InAbilityCDO = InAbilityToActivate.GetDefaultObject();
+	AbilityBlocks.Add(Block);
+	AddLooseGameplayTag(Block.Tag);
+}
 
-	for (const FGameplayAbilitySpec &ActivatableSpec : ActivatableAbilities.Items)
+void UPLAbilitySystemComponent::RemoveAbilityBlocks(TFunctionRef<bool(const FPLAbilityBlock &)> Predicate)
+{
+	// the tags are removed after the blocks, since removing a tag can trigger abilities, which add new blocks
+	TArray<FGameplayTag, TInlineAllocator<NumInlineAbilityBlocks>> RemovedTags{};
+	for (int32 BlockIndex = AbilityBlocks.Num() - 1; BlockIndex >= 0; --BlockIndex)
 	{
-		if (ActivatableSpec.Ability == InAbilityCDO)
+		if (Predicate(AbilityBlocks[BlockIndex]))
 		{
-			const FGameplayAbilitySpec *const Spec = FindAbilitySpecFromHandle(ActivatableSpec.Handle);
+			RemovedTags.Add(AbilityBlocks[BlockIndex].Tag);
+			AbilityBlocks.RemoveAtSwap(BlockIndex, 1, false);
+		}
+	}
+
+	for (const FGameplayTag &RemovedTag : RemovedTags)
+	{
+		RemoveLooseGameplayTag(RemovedTag);
+	}
+}
 
-			// try to get the ability instance
-			// Note: we need a instanced ability to be able to bind to its "Event Dispatchers"
-			UGameplayAbility *AbilityInstance = Spec->GetPrimaryInstance();
+void UPLAbilitySystemComponent::UpdateAbilityCooldowns()
+{
+	UWorld *World = GetWorld();
+	if (!World)
+	{
+		return;
+	}
 
-			if (AbilityInstance)
-			{
-				OutIsInstance = true;
-				return AbilityInstance;
-			}
-			else
-			{
-				// default to the CDO if we can't
-				OutIsInstance = false;
-				return Spec->Ability;
-			}
+	const double Now{World->GetTimeSeconds()};
+	RemoveAbilityBlocks([Now](const FPLAbilityBlock &Block)
+						{ return !Block.bUntilGrounded && (Block.EndTime <= Now); });
+
+	// only a single timer is needed for the next ending cooldown
+	double NextEndTime{TNumericLimits<double>::Max()};
+	for (const FPLAbilityBlock &Block : AbilityBlocks)
+	{
+		if (!Block.bUntilGrounded)
+		{
+			NextEndTime = FMath::Min(NextEndTime, Block.EndTime);
 		}
 	}
 
-	return nullptr;
-}
\ No newline at end of file
+	if (NextEndTime < TNumericLimits<double>::Max())
+	{
+		World->GetTimerManager().SetTimer(AbilityCooldownTimerHandle, this, &UPLAbilitySystemComponent::UpdateAbilityCooldowns, static_cast<float>(NextEndTime - Now), false);
+	}
+	else
+	{
+		World->GetTimerManager().ClearTimer(AbilityCooldownTimerHandle);
+	}
+}
+
+void UPLAbilitySystemComponent::OnAttributeChangedForActivationCache(const FOnAttributeChangeData &)
+{
+	InvalidateActivationCache();
+}
+
+void UPLAbilitySystemComponent::OnBlockedAbilityTagChanged(const FGameplayTag, int32)
+{
+	InvalidateActivationCache();
+}
+
+bool UPLAbilitySystemComponent::FindActivationCacheResult(const FGameplayAbilitySpec &AbilitySpec, bool &bOutCanActivate) const
+{
+	if (const FPLActivationCacheEntry *Entry = ActivationCache.Find(AbilitySpec.Handle); Entry && CVarPLActivationCache.GetValueOnGameThread() && (Entry->FrameCounter == GFrameCounter) && (Entry->Generation == ActivationCacheGeneration))
+	{
+		bOutCanActivate = Entry->bCanActivate;
+		return true;
+	}
+
+	return false;
+}
+
+void UPLAbilitySystemComponent::SetActivationCacheResult(FGameplayAbilitySpecHandle AbilitySpecHandle, bool bCanActivate)
+{
+	LLM_SCOPE_BYTAG(ProjectLux_Caches);
+	FPLActivationCacheEntry &Entry = ActivationCache.FindOrAdd(AbilitySpecHandle);
+	Entry.FrameCounter = GFrameCounter;
+	Entry.Generation = ActivationCacheGeneration;
+	Entry.bCanActivate = bCanActivate;
+}
@@ -0,0 +1,60 @@
+// Copyright TinyAlmonds (Alex Noerdemann)
+
+#include "Core/AbilitySystem/PLAbilitySystemDelegateBindings.h"
+
+#include "AbilitySystemComponent.h"
+
+void FPLAbilitySystemDelegateBindings::BindAttributeValueChange(UAbilitySystemComponent &InAbilitySystemComponent, const FGameplayAttribute &Attribute, FOnGameplayAttributeValueChange::FDelegate Delegate)
+{
+	SetAbilitySystemComponent(InAbilitySystemComponent);
+
+	FAttributeBinding Binding{};
+	Binding.Attribute = Attribute;
+	Binding.Handle = InAbilitySystemComponent.GetGameplayAttributeValueChangeDelegate(Attribute).Add(MoveTemp(Delegate));
+	AttributeBindings.Add(Binding);
+}
+
+void FPLAbilitySystemDelegateBindings::BindGameplayTagEvent(UAbilitySystemComponent &InAbilitySystemComponent, const FGameplayTag &Tag, EGameplayTagEventType::Type EventType, FOnGameplayEffectTagCountChanged::FDelegate Delegate)
+{
+	SetAbilitySystemComponent(InAbilitySystemComponent);
+
+	FGameplayTagBinding Binding{};
+	Binding.Tag = Tag;
+	Binding.EventType = EventType;
+	Binding.Handle = InAbilitySystemComponent.RegisterGameplayTagEvent(Tag, EventType).Add(MoveTemp(Delegate));
+	GameplayTagBindings.Add(Binding);
+}
+
+void FPLAbilitySystemDelegateBindings::UnbindAll()
+{
+	if (UAbilitySystemComponent *BoundAbilitySystemComponent = AbilitySystemComponent.Get(); BoundAbilitySystemComponent)
+	{
+		for (const FAttributeBinding &Binding : AttributeBindings)
+		{
+			BoundAbilitySystemComponent->GetGameplayAttributeValueChangeDelegate(Binding.Attribute).Remove(Binding.Handle);
+		}
+
+		for (const FGameplayTagBinding &Binding : GameplayTagBindings)
+		{
+			BoundAbilitySystemComponent->UnregisterGameplayTagEvent(Binding.Handle, Binding.Tag, Binding.EventType);
+		}
+	}
+
+	AbilitySystemComponent.Reset();
+	AttributeBindings.Reset();
+	GameplayTagBindings.Reset();
+}
+
+int32 FPLAbilitySystemDelegateBindings::Num() const
+{
+	return AttributeBindings.Num() + GameplayTagBindings.Num();
+}
+
+void FPLAbilitySystemDelegateBindings::SetAbilitySystemComponent(UAbilitySystemComponent &NewAbilitySystemComponent)
+{
+	if (AbilitySystemComponent.Get() != &NewAbilitySystemComponent)
+	{
+		UnbindAll();
+		AbilitySystemComponent = &NewAbilitySystemComponent;
+	}
+}
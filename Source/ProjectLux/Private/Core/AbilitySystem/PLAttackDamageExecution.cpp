@@ -7,6 +7,8 @@
 #include "GenericPlatform/GenericPlatformMath.h"
 
 #include "Core/AbilitySystem/PLCharacterAttributeSet.h"
+#include "Core/AbilitySystem/PLGameplayTags.h"
+#include "Core/Subsystem/PLHitchDetectorSubsystem.h"
 
 /**
  * Struct to capture all needed attributes for the damage calculation from character attacks.
@@ -88,6 +90,8 @@ UPLAttackDamageExecution::UPLAttackDamageExecution()
 
 void UPLAttackDamageExecution::Execute_Implementation(const FGameplayEffectCustomExecutionParameters &ExecutionParams, OUT FGameplayEffectCustomExecutionOutput &OutExecutionOutput) const
 {
+	PL_SCOPE_HITCH_STAGE(DamageExecution);
+
 	const FGameplayEffectSpec &Spec = ExecutionParams.GetOwningSpec();
 
 	// Gather the tags from the source and target as that can affect which buffs should be used
@@ -157,8 +161,12 @@ void UPLAttackDamageExecution::Execute_Implementation(const FGameplayEffectCusto
 	{
 		OutExecutionOutput.AddOutputModifier(FGameplayModifierEvaluatedData(AttackDamageStatics().ReceivedDamageProperty, EGameplayModOp::Additive, TotalDamageTargetReceives));
 
-		// trigger conditional effect to apply immunity from attack ability to prevent multiple hits in one swing
-		OutExecutionOutput.MarkConditionalGameplayEffectsToTrigger();
+		// trigger conditional effect to apply immunity from attack ability to prevent multiple hits in one swing,
+		// unless the spec was applied by a swing of a UPLMeleeHitComponent (marked by its dynamic asset tag), which already hits every target at most once
+		if (!ExecutionParams.GetOwningSpec().GetDynamicAssetTags().HasTagExact(PLGameplayTags::GameplayEffect_Damage_MeleeSwing))
+		{
+			OutExecutionOutput.MarkConditionalGameplayEffectsToTrigger();
+		}
 	}
 }
 
@@ -0,0 +1,57 @@
+// Copyright TinyAlmonds (Alex Noerdemann)
+
+#include "Core/AbilitySystem/PLAttributeSnapshot.h"
+
+#include "AbilitySystemComponent.h"
+
+FPLAttributeSnapshot FPLAttributeSnapshot::Capture(const UAbilitySystemComponent &AbilitySystemComponent)
+{
+	FPLAttributeSnapshot Snapshot{};
+
+	for (const UAttributeSet *AttributeSet : AbilitySystemComponent.GetSpawnedAttributes())
+	{
+		if (!AttributeSet)
+		{
+			continue;
+		}
+
+		for (TFieldIterator<FProperty> PropertyIt(AttributeSet->GetClass()); PropertyIt; ++PropertyIt)
+		{
+			if (FGameplayAttribute::IsGameplayAttributeDataProperty(*PropertyIt))
+			{
+				Snapshot.Attributes.Emplace(*PropertyIt);
+			}
+		}
+	}
+
+	// limits have to be restored first, since the attribute sets clamp the other attributes against them
+	Snapshot.Attributes.StableSort([](const FGameplayAttribute &Lhs, const FGameplayAttribute &Rhs)
+								   {
+									   const bool bLhsIsLimit{Lhs.AttributeName.StartsWith(TEXT("Max")) || Lhs.AttributeName.StartsWith(TEXT("Min"))};
+									   const bool bRhsIsLimit{Rhs.AttributeName.StartsWith(TEXT("Max")) || Rhs.AttributeName.StartsWith(TEXT("Min"))};
+									   return bLhsIsLimit && !bRhsIsLimit; });
+
+	Snapshot.BaseValues.Reserve(Snapshot.Attributes.Num());
+	for (const FGameplayAttribute &Attribute : Snapshot.Attributes)
+	{
+		Snapshot.BaseValues.Add(AbilitySystemComponent.GetNumericAttributeBase(Attribute));
+	}
+
+	return Snapshot;
+}
+
+void FPLAttributeSnapshot::Restore(UAbilitySystemComponent &AbilitySystemComponent) const
+{
+	for (int32 AttributeIndex = 0; AttributeIndex < Attributes.Num(); ++AttributeIndex)
+	{
+		if (AbilitySystemComponent.HasAttributeSetForAttribute(Attributes[AttributeIndex]))
+		{
+			AbilitySystemComponent.SetNumericAttributeBase(Attributes[AttributeIndex], BaseValues[AttributeIndex]);
+		}
+	}
+}
+
+bool FPLAttributeSnapshot::IsEmpty() const
+{
+	return Attributes.IsEmpty();
+}
@@ -0,0 +1,19 @@
+// Copyright TinyAlmonds (Alex Noerdemann)
+
+#include "Core/AbilitySystem/PLGameplayTags.h"
+
+namespace PLGameplayTags
+{
+	UE_DEFINE_GAMEPLAY_TAG_COMMENT(Ability_Combat_Attack, "Ability.Combat.Attack", "Tag describing the Attack ability.");
+	UE_DEFINE_GAMEPLAY_TAG_COMMENT(Ability_Movement_Dash, "Ability.Movement.Dash", "Tag describing the Dash ability.");
+	UE_DEFINE_GAMEPLAY_TAG_COMMENT(Ability_Movement_DoubleDash, "Ability.Movement.DoubleDash", "Tag describing the Double-Dash ability.");
+	UE_DEFINE_GAMEPLAY_TAG_COMMENT(Ability_Movement_Glide, "Ability.Movement.Glide", "Tag describing the Glide ability.");
+	UE_DEFINE_GAMEPLAY_TAG_COMMENT(Ability_Movement_QuickStep, "Ability.Movement.QuickStep", "Tag describing the QuickStep ability.");
+	UE_DEFINE_GAMEPLAY_TAG_COMMENT(Ability_Movement_Sprint, "Ability.Movement.Sprint", "Tag describing the Sprint ability.");
+	UE_DEFINE_GAMEPLAY_TAG_COMMENT(Ability_Movement_WallJump, "Ability.Movement.WallJump", "Tag describing the Wall Jump ability.");
+	UE_DEFINE_GAMEPLAY_TAG_COMMENT(Ability_Movement_WallSlide, "Ability.Movement.WallSlide", "Tag describing the Wall Slide ability.");
+	UE_DEFINE_GAMEPLAY_TAG_COMMENT(Cooldown, "Cooldown", "Parent tag of the tags granted by cooldowns.");
+	UE_DEFINE_GAMEPLAY_TAG_COMMENT(GameplayEffect_Damage_MeleeSwing, "GameplayEffect.Damage.MeleeSwing", "Dynamic asset tag of the damage effect specs applied by a swing of a UPLMeleeHitComponent.");
+	UE_DEFINE_GAMEPLAY_TAG_COMMENT(Reject_MoveInput, "Reject.MoveInput", "Tag of abilities blocking the MoveRight-/Up input.");
+	UE_DEFINE_GAMEPLAY_TAG_COMMENT(Status_Dead, "Status.Dead", "Tag describing the death of a character.");
+}
@@ -0,0 +1,274 @@
+// Copyright TinyAlmonds (Alex Noerdemann)
+
+#include "Core/Benchmark/PLBenchmarkUtils.h"
+
+#include "Dom/JsonObject.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/WorldSettings.h"
+#include "HAL/MemoryBase.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+#include <atomic>
+
+DEFINE_LOG_CATEGORY_STATIC(LogPLBenchmark, Log, All);
+
+namespace
+{
+	/**
+	 * Allocator forwarding every call to the wrapped allocator, while counting the allocations.
+	 */
+	class FPLCountingMalloc final : public FMalloc
+	{
+	public:
+		/** The wrapped allocator. Set when the counting scope is entered. */
+		FMalloc *InnerMalloc{nullptr};
+
+		std::atomic<uint64> NumAllocations{0};
+		std::atomic<uint64> NumAllocatedBytes{0};
+
+		virtual void *Malloc(SIZE_T Count, uint32 Alignment) override
+		{
+			CountAllocation(Count);
+			return InnerMalloc->Malloc(Count, Alignment);
+		}
+
+		virtual void *TryMalloc(SIZE_T Count, uint32 Alignment) override
+		{
+			CountAllocation(Count);
+			return InnerMalloc->TryMalloc(Count, Alignment);
+		}
+
+		virtual void *Realloc(void *Original, SIZE_T Count, uint32 Alignment) override
+		{
+			if (Original == nullptr)
+			{
+				CountAllocation(Count);
+			}
+			return InnerMalloc->Realloc(Original, Count, Alignment);
+		}
+
+		virtual void *TryRealloc(void *Original, SIZE_T Count, uint32 Alignment) override
+		{
+			if (Original == nullptr)
+			{
+				CountAllocation(Count);
+			}
+			return InnerMalloc->TryRealloc(Original, Count, Alignment);
+		}
+
+		virtual void Free(void *Original) override
+		{
+			InnerMalloc->Free(Original);
+		}
+
+		virtual bool GetAllocationSize(void *Original, SIZE_T &SizeOut) override
+		{
+			return InnerMalloc->GetAllocationSize(Original, SizeOut);
+		}
+
+		virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override
+		{
+			return InnerMalloc->QuantizeSize(Count, Alignment);
+		}
+
+		virtual void Trim(bool bTrimThreadCaches) override
+		{
+			InnerMalloc->Trim(bTrimThreadCaches);
+		}
+
+		virtual void SetupTLSCachesOnCurrentThread() override
+		{
+			InnerMalloc->SetupTLSCachesOnCurrentThread();
+		}
+
+		virtual void ClearAndDisableTLSCachesOnCurrentThread() override
+		{
+			InnerMalloc->ClearAndDisableTLSCachesOnCurrentThread();
+		}
+
+		virtual void InitializeStatsMetadata() override
+		{
+			InnerMalloc->InitializeStatsMetadata();
+		}
+
+		virtual void UpdateStats() override
+		{
+			InnerMalloc->UpdateStats();
+		}
+
+		virtual void GetAllocatorStats(FGenericMemoryStats &OutStats) override
+		{
+			InnerMalloc->GetAllocatorStats(OutStats);
+		}
+
+		virtual void DumpAllocatorStats(FOutputDevice &Ar) override
+		{
+			InnerMalloc->DumpAllocatorStats(Ar);
+		}
+
+		virtual bool IsInternallyThreadSafe() const override
+		{
+			return InnerMalloc->IsInternallyThreadSafe();
+		}
+
+		virtual bool ValidateHeap() override
+		{
+			return InnerMalloc->ValidateHeap();
+		}
+
+		virtual const TCHAR *GetDescriptiveName() override
+		{
+			return TEXT("PLCountingMalloc");
+		}
+
+	private:
+		void CountAllocation(SIZE_T Count)
+		{
+			NumAllocations.fetch_add(1, std::memory_order_relaxed);
+			NumAllocatedBytes.fetch_add(Count, std::memory_order_relaxed);
+		}
+	};
+
+	/**
+	 * Returns the process wide counting allocator.
+	 * @note The instance is intentionally never destroyed, since other threads may still hold a pointer to it after the counting scope ended.
+	 */
+	FPLCountingMalloc &GetCountingMalloc()
+	{
+		static FPLCountingMalloc *CountingMalloc = new FPLCountingMalloc();
+		return *CountingMalloc;
+	}
+
+	double GetPercentileOfSortedSamples(const TArray<double> &SortedSamples, double Percentile)
+	{
+		const int32 Index = FMath::Clamp(FMath::CeilToInt32(Percentile * SortedSamples.Num()) - 1, 0, SortedSamples.Num() - 1);
+		return SortedSamples[Index];
+	}
+}
+
+FPLBenchmarkSampleStatistics FPLBenchmarkSampleStatistics::FromSamples(TArray<double> &Samples)
+{
+	FPLBenchmarkSampleStatistics Statistics{};
+	if (Samples.IsEmpty())
+	{
+		return Statistics;
+	}
+
+	Samples.Sort();
+
+	double Sum{0.0};
+	for (const double Sample : Samples)
+	{
+		Sum += Sample;
+	}
+
+	Statistics.Mean = Sum / Samples.Num();
+	Statistics.Min = Samples[0];
+	Statistics.Max = Samples.Last();
+	Statistics.P50 = GetPercentileOfSortedSamples(Samples, 0.50);
+	Statistics.P90 = GetPercentileOfSortedSamples(Samples, 0.90);
+	Statistics.P99 = GetPercentileOfSortedSamples(Samples, 0.99);
+
+	return Statistics;
+}
+
+TSharedRef<FJsonObject> FPLBenchmarkSampleStatistics::ToJson() const
+{
+	TSharedRef<FJsonObject> JsonObject = MakeShared<FJsonObject>();
+	JsonObject->SetNumberField(TEXT("mean"), Mean);
+	JsonObject->SetNumberField(TEXT("min"), Min);
+	JsonObject->SetNumberField(TEXT("max"), Max);
+	JsonObject->SetNumberField(TEXT("p50"), P50);
+	JsonObject->SetNumberField(TEXT("p90"), P90);
+	JsonObject->SetNumberField(TEXT("p99"), P99);
+
+	return JsonObject;
+}
+
+FPLScopedAllocationCounter::FPLScopedAllocationCounter()
+{
+	FPLCountingMalloc &CountingMalloc = GetCountingMalloc();
+	check(GMalloc != &CountingMalloc);
+
+	PreviousMalloc = GMalloc;
+	CountingMalloc.InnerMalloc = PreviousMalloc;
+	GMalloc = &CountingMalloc;
+
+	Reset();
+}
+
+FPLScopedAllocationCounter::~FPLScopedAllocationCounter()
+{
+	// We only restore the previous allocator. The counting allocator stays a valid forwarding proxy for late callers.
+	GMalloc = PreviousMalloc;
+}
+
+uint64 FPLScopedAllocationCounter::GetNumAllocations() const
+{
+	return GetCountingMalloc().NumAllocations.load(std::memory_order_relaxed) - NumAllocationsAtReset;
+}
+
+uint64 FPLScopedAllocationCounter::GetNumAllocatedBytes() const
+{
+	return GetCountingMalloc().NumAllocatedBytes.load(std::memory_order_relaxed) - NumAllocatedBytesAtReset;
+}
+
+void FPLScopedAllocationCounter::Reset()
+{
+	NumAllocationsAtReset = GetCountingMalloc().NumAllocations.load(std::memory_order_relaxed);
+	NumAllocatedBytesAtReset = GetCountingMalloc().NumAllocatedBytes.load(std::memory_order_relaxed);
+}
+
+UWorld *PLBenchmarkUtils::CreateWorld(FName WorldName)
+{
+	UWorld *World = UWorld::CreateWorld(EWorldType::Game, false, WorldName);
+	FWorldContext &WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+
+	World->InitializeActorsForPlay(FURL{});
+
+	// Without a GameMode the world does not dispatch BeginPlay on its own.
+	World->BeginPlay();
+	if (!World->HasBegunPlay())
+	{
+		World->GetWorldSettings()->NotifyBeginPlay();
+	}
+
+	return World;
+}
+
+void PLBenchmarkUtils::DestroyWorld(UWorld *World)
+{
+	if (World)
+	{
+		GEngine->DestroyWorldContext(World);
+		World->DestroyWorld(false);
+	}
+}
+
+bool PLBenchmarkUtils::WriteResult(const TSharedRef<FJsonObject> &JsonObject, const FString &OutputFilePath, const FString &DefaultFileName)
+{
+	FString JsonString{};
+	TSharedRef<TJsonWriter<>> JsonWriter = TJsonWriterFactory<>::Create(&JsonString);
+	if (!FJsonSerializer::Serialize(JsonObject, JsonWriter))
+	{
+		UE_LOG(LogPLBenchmark, Error, TEXT("Failed to serialize the benchmark result."));
+		return false;
+	}
+
+	UE_LOG(LogPLBenchmark, Display, TEXT("%s"), *JsonString);
+
+	const FString FilePath = OutputFilePath.IsEmpty() ? FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Benchmarks"), DefaultFileName + TEXT(".json")) : OutputFilePath;
+	if (!FFileHelper::SaveStringToFile(JsonString, *FilePath))
+	{
+		UE_LOG(LogPLBenchmark, Error, TEXT("Failed to write the benchmark result to '%s'."), *FilePath);
+		return false;
+	}
+
+	UE_LOG(LogPLBenchmark, Display, TEXT("Benchmark result written to '%s'."), *FilePath);
+	return true;
+}
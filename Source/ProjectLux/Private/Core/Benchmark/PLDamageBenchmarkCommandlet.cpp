@@ -0,0 +1,313 @@
+// Copyright TinyAlmonds (Alex Noerdemann)
+
+#include "Core/Benchmark/PLDamageBenchmarkCommandlet.h"
+
+#include "AbilitySystemComponent.h"
+#include "Dom/JsonObject.h"
+#include "Engine/World.h"
+#include "GameplayEffect.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "Misc/Parse.h"
+
+#include "Core/AbilitySystem/PLAttackDamageExecution.h"
+#include "Core/AbilitySystem/PLCharacterAttributeSet.h"
+#include "Core/Benchmark/PLBenchmarkUtils.h"
+#include "Core/PLEnemyCharacterBase.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogPLDamageBenchmark, Log, All);
+
+namespace
+{
+	/**
+	 * Returns the fuzzable attributes of the UPLCharacterAttributeSet (i.e. all except the meta attribute ReceivedDamage).
+	 * Limiting attributes (e.g. MaxHealth) are ordered before the attributes they clamp.
+	 */
+	const TArray<FGameplayAttribute> &GetCharacterAttributesInClampOrder()
+	{
+		static const TArray<FGameplayAttribute> Attributes = []()
+		{
+			const TArray<FGameplayAttribute> LimitAttributes{
+				UPLCharacterAttributeSet::GetMaxHealthAttribute(),
+				UPLCharacterAttributeSet::GetMinEmotionalDamageMultiplierAttribute(),
+				UPLCharacterAttributeSet::GetMinEmotionalResistanceAttribute(),
+				UPLCharacterAttributeSet::GetMaxEmotionalResistanceAttribute()};
+
+			TArray<FGameplayAttribute> OrderedAttributes{LimitAttributes};
+			for (TFieldIterator<FProperty> PropertyIt(UPLCharacterAttributeSet::StaticClass()); PropertyIt; ++PropertyIt)
+			{
+				if (FGameplayAttribute::IsGameplayAttributeDataProperty(*PropertyIt))
+				{
+					const FGameplayAttribute Attribute{*PropertyIt};
+					if (!LimitAttributes.Contains(Attribute) && (Attribute != UPLCharacterAttributeSet::GetReceivedDamageAttribute()))
+					{
+						OrderedAttributes.Add(Attribute);
+					}
+				}
+			}
+			return OrderedAttributes;
+		}();
+
+		return Attributes;
+	}
+
+	void SetAttributeBase(UAbilitySystemComponent *AbilitySystem, const FGameplayAttribute &Attribute, float Value)
+	{
+		AbilitySystem->SetNumericAttributeBase(Attribute, Value);
+	}
+}
+
+UPLDamageBenchmarkCommandlet::UPLDamageBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsEditor = false;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UPLDamageBenchmarkCommandlet::Main(const FString &Params)
+{
+	int32 NumExecutions{1000000};
+	int32 NumFuzzIterations{100000};
+	int32 Seed{0};
+	FString OutputFilePath{};
+	FParse::Value(*Params, TEXT("Executions="), NumExecutions);
+	FParse::Value(*Params, TEXT("FuzzIterations="), NumFuzzIterations);
+	FParse::Value(*Params, TEXT("Seed="), Seed);
+	FParse::Value(*Params, TEXT("Output="), OutputFilePath);
+
+	UWorld *World = PLBenchmarkUtils::CreateWorld(TEXT("PLDamageBenchmarkWorld"));
+
+	// synthetic source and target characters, which are possessed to initialize their ASCs
+	FActorSpawnParameters SpawnParameters{};
+	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	APLEnemyCharacterBase *Source = World->SpawnActor<APLEnemyCharacterBase>(FVector{0.0, 0.0, 0.0}, FRotator::ZeroRotator, SpawnParameters);
+	APLEnemyCharacterBase *Target = World->SpawnActor<APLEnemyCharacterBase>(FVector{200.0, 0.0, 0.0}, FRotator::ZeroRotator, SpawnParameters);
+	Source->SpawnDefaultController();
+	Target->SpawnDefaultController();
+	UAbilitySystemComponent *SourceAbilitySystem = Source->GetAbilitySystemComponent();
+	UAbilitySystemComponent *TargetAbilitySystem = Target->GetAbilitySystemComponent();
+
+	// instant effect, which only runs the damage execution (like the attack damage effect of the game)
+	UGameplayEffect *DamageEffect = NewObject<UGameplayEffect>(GetTransientPackage(), TEXT("GE_PLDamageBenchmark"));
+	DamageEffect->DurationPolicy = EGameplayEffectDurationType::Instant;
+	FGameplayEffectExecutionDefinition DamageExecution{};
+	DamageExecution.CalculationClass = UPLAttackDamageExecution::StaticClass();
+	DamageEffect->Executions.Add(DamageExecution);
+
+	// representative attribute values for the throughput measurement
+	static constexpr float TargetHealth{1000000.0f};
+	SetAttributeBase(SourceAbilitySystem, UPLCharacterAttributeSet::GetRawDamageAttribute(), 10.0f);
+	SetAttributeBase(SourceAbilitySystem, UPLCharacterAttributeSet::GetFearDamageMultiplierAttribute(), 0.5f);
+	SetAttributeBase(SourceAbilitySystem, UPLCharacterAttributeSet::GetJoyDamageMultiplierAttribute(), 0.5f);
+	SetAttributeBase(TargetAbilitySystem, UPLCharacterAttributeSet::GetArmorAttribute(), 5.0f);
+	SetAttributeBase(TargetAbilitySystem, UPLCharacterAttributeSet::GetFearResistanceAttribute(), 0.5f);
+	SetAttributeBase(TargetAbilitySystem, UPLCharacterAttributeSet::GetJoyResistanceAttribute(), 0.25f);
+	SetAttributeBase(TargetAbilitySystem, UPLCharacterAttributeSet::GetMaxHealthAttribute(), TargetHealth);
+	SetAttributeBase(TargetAbilitySystem, UPLCharacterAttributeSet::GetHealthAttribute(), TargetHealth);
+
+	// throughput: the executions are timed in batches to get a distribution of the cost per execution
+	static constexpr int32 ExecutionsPerBatch{1000};
+	TArray<double> NanosecondsPerExecution{};
+	NanosecondsPerExecution.Reserve(NumExecutions / ExecutionsPerBatch + 1);
+	uint64 TotalCycles{0};
+	uint64 NumAllocations{0};
+	uint64 NumAllocatedBytes{0};
+	{
+		FPLScopedAllocationCounter AllocationCounter{};
+		for (int32 ExecutionsDone = 0; ExecutionsDone < NumExecutions; ExecutionsDone += ExecutionsPerBatch)
+		{
+			const int32 NumBatchExecutions = FMath::Min(ExecutionsPerBatch, NumExecutions - ExecutionsDone);
+
+			const uint64 BatchStartCycles = FPlatformTime::Cycles64();
+			for (int32 Execution = 0; Execution < NumBatchExecutions; ++Execution)
+			{
+				const FGameplayEffectSpec DamageSpec{DamageEffect, SourceAbilitySystem->MakeEffectContext(), 1.0f};
+				SourceAbilitySystem->ApplyGameplayEffectSpecToTarget(DamageSpec, TargetAbilitySystem);
+			}
+			const uint64 BatchCycles = FPlatformTime::Cycles64() - BatchStartCycles;
+
+			TotalCycles += BatchCycles;
+			NanosecondsPerExecution.Add(FPlatformTime::ToMilliseconds64(BatchCycles) * 1000000.0 / NumBatchExecutions);
+
+			// keep the target alive, so that every execution runs the same path (not part of the measurement)
+			NumAllocations += AllocationCounter.GetNumAllocations();
+			NumAllocatedBytes += AllocationCounter.GetNumAllocatedBytes();
+			SetAttributeBase(TargetAbilitySystem, UPLCharacterAttributeSet::GetHealthAttribute(), TargetHealth);
+			AllocationCounter.Reset();
+		}
+	}
+	const double TotalSeconds = FPlatformTime::ToSeconds64(TotalCycles);
+
+	// fuzzing
+	FRandomStream RandomStream{Seed};
+	TArray<FString> Violations{};
+	UPLCharacterAttributeSet *FuzzAttributeSet = NewObject<UPLCharacterAttributeSet>(GetTransientPackage());
+	for (int32 Iteration = 0; Iteration < NumFuzzIterations; ++Iteration)
+	{
+		FuzzAttributeClamping(RandomStream, *FuzzAttributeSet, Violations);
+		FuzzDamageExecution(RandomStream, DamageEffect, SourceAbilitySystem, TargetAbilitySystem, Violations);
+	}
+
+	TSharedRef<FJsonObject> Result = MakeShared<FJsonObject>();
+	Result->SetStringField(TEXT("benchmark"), TEXT("damageExecution"));
+	Result->SetNumberField(TEXT("executions"), NumExecutions);
+	Result->SetNumberField(TEXT("seconds"), TotalSeconds);
+	Result->SetNumberField(TEXT("executionsPerSecond"), (TotalSeconds > 0.0) ? (NumExecutions / TotalSeconds) : 0.0);
+	Result->SetNumberField(TEXT("allocationsPerExecution"), (NumExecutions > 0) ? (static_cast<double>(NumAllocations) / NumExecutions) : 0.0);
+	Result->SetNumberField(TEXT("allocatedBytesPerExecution"), (NumExecutions > 0) ? (static_cast<double>(NumAllocatedBytes) / NumExecutions) : 0.0);
+	Result->SetObjectField(TEXT("nanosecondsPerExecution"), FPLBenchmarkSampleStatistics::FromSamples(NanosecondsPerExecution).ToJson());
+
+	TSharedRef<FJsonObject> Fuzz = MakeShared<FJsonObject>();
+	Fuzz->SetNumberField(TEXT("iterations"), NumFuzzIterations);
+	Fuzz->SetNumberField(TEXT("seed"), Seed);
+	Fuzz->SetNumberField(TEXT("violations"), Violations.Num());
+	TArray<TSharedPtr<FJsonValue>> ReportedViolations{};
+	for (int32 ViolationIndex = 0; ViolationIndex < FMath::Min(Violations.Num(), MaxReportedViolations); ++ViolationIndex)
+	{
+		ReportedViolations.Add(MakeShared<FJsonValueString>(Violations[ViolationIndex]));
+	}
+	Fuzz->SetArrayField(TEXT("reportedViolations"), ReportedViolations);
+	Result->SetObjectField(TEXT("fuzz"), Fuzz);
+
+	const bool bResultWritten = PLBenchmarkUtils::WriteResult(Result, OutputFilePath, TEXT("DamageBenchmark"));
+
+	PLBenchmarkUtils::DestroyWorld(World);
+
+	if (!Violations.IsEmpty())
+	{
+		UE_LOG(LogPLDamageBenchmark, Error, TEXT("Fuzzing found %d violations. First: %s"), Violations.Num(), *Violations[0]);
+	}
+
+	return (bResultWritten && Violations.IsEmpty()) ? 0 : 1;
+}
+
+void UPLDamageBenchmarkCommandlet::FuzzAttributeClamping(FRandomStream &RandomStream, UPLCharacterAttributeSet &AttributeSet, TArray<FString> &OutViolations) const
+{
+	// the clamping of an attribute depends on the attributes before it, so every iteration starts from the default values
+	UPLCharacterAttributeSet *DefaultAttributeSet = GetMutableDefault<UPLCharacterAttributeSet>();
+	for (const FGameplayAttribute &Attribute : GetCharacterAttributesInClampOrder())
+	{
+		if (FGameplayAttributeData *AttributeData = Attribute.GetGameplayAttributeData(&AttributeSet); AttributeData)
+		{
+			*AttributeData = *Attribute.GetGameplayAttributeData(DefaultAttributeSet);
+		}
+	}
+
+	// SetNumericValueChecked() passes the value through PreAttributeChange(), which does the clamping.
+	for (const FGameplayAttribute &Attribute : GetCharacterAttributesInClampOrder())
+	{
+		float Value = DrawFuzzValue(RandomStream);
+		Attribute.SetNumericValueChecked(Value, &AttributeSet);
+	}
+
+	CheckAttributeInvariants(AttributeSet, TEXT("Clamping"), OutViolations);
+}
+
+void UPLDamageBenchmarkCommandlet::FuzzDamageExecution(FRandomStream &RandomStream, const UGameplayEffect *DamageEffect, UAbilitySystemComponent *SourceAbilitySystem, UAbilitySystemComponent *TargetAbilitySystem, TArray<FString> &OutViolations) const
+{
+	for (const FGameplayAttribute &Attribute : GetCharacterAttributesInClampOrder())
+	{
+		SetAttributeBase(SourceAbilitySystem, Attribute, DrawFuzzValue(RandomStream));
+		SetAttributeBase(TargetAbilitySystem, Attribute, DrawFuzzValue(RandomStream));
+	}
+
+	const UPLCharacterAttributeSet *TargetAttributeSet = TargetAbilitySystem->GetSet<UPLCharacterAttributeSet>();
+	const float HealthBeforeExecution = TargetAttributeSet->GetHealth();
+
+	const FGameplayEffectSpec DamageSpec{DamageEffect, SourceAbilitySystem->MakeEffectContext(), 1.0f};
+	SourceAbilitySystem->ApplyGameplayEffectSpecToTarget(DamageSpec, TargetAbilitySystem);
+
+	CheckAttributeInvariants(*TargetAttributeSet, TEXT("DamageExecution"), OutViolations);
+	if (TargetAttributeSet->GetHealth() > HealthBeforeExecution)
+	{
+		OutViolations.Add(FString::Printf(TEXT("DamageExecution: Health increased from %g to %g."), HealthBeforeExecution, TargetAttributeSet->GetHealth()));
+	}
+	if (TargetAttributeSet->GetReceivedDamage() != 0.0f)
+	{
+		OutViolations.Add(FString::Printf(TEXT("DamageExecution: ReceivedDamage was not consumed (%g)."), TargetAttributeSet->GetReceivedDamage()));
+	}
+}
+
+void UPLDamageBenchmarkCommandlet::CheckAttributeInvariants(const UPLCharacterAttributeSet &AttributeSet, const TCHAR *Context, TArray<FString> &OutViolations)
+{
+	auto AddViolation = [&OutViolations, Context](const FGameplayAttribute &Attribute, float Value, const TCHAR *Expectation)
+	{
+		OutViolations.Add(FString::Printf(TEXT("%s: %s = %g, expected %s."), Context, *Attribute.GetName(), Value, Expectation));
+	};
+
+	for (const FGameplayAttribute &Attribute : GetCharacterAttributesInClampOrder())
+	{
+		const float Value = Attribute.GetNumericValue(&AttributeSet);
+		if (!FMath::IsFinite(Value))
+		{
+			AddViolation(Attribute, Value, TEXT("a finite value"));
+			continue;
+		}
+
+		if (Attribute == UPLCharacterAttributeSet::GetHealthAttribute())
+		{
+			if ((Value < 0.0f) || (Value > AttributeSet.GetMaxHealth()))
+			{
+				AddViolation(Attribute, Value, TEXT("a value in [0, MaxHealth]"));
+			}
+		}
+		else if (Attribute == UPLCharacterAttributeSet::GetMaxHealthAttribute())
+		{
+			if (Value < 1.0f)
+			{
+				AddViolation(Attribute, Value, TEXT("a value >= 1"));
+			}
+		}
+		else if ((Attribute == UPLCharacterAttributeSet::GetRawDamageAttribute()) || (Attribute == UPLCharacterAttributeSet::GetArmorAttribute()) || (Attribute == UPLCharacterAttributeSet::GetMinEmotionalDamageMultiplierAttribute()))
+		{
+			if (Value < 0.0f)
+			{
+				AddViolation(Attribute, Value, TEXT("a value >= 0"));
+			}
+		}
+		else if ((Attribute == UPLCharacterAttributeSet::GetMinEmotionalResistanceAttribute()) || (Attribute == UPLCharacterAttributeSet::GetMaxEmotionalResistanceAttribute()))
+		{
+			if ((Value < 0.0f) || (Value > 1.0f))
+			{
+				AddViolation(Attribute, Value, TEXT("a value in [0, 1]"));
+			}
+		}
+		else if (Attribute.AttributeName.EndsWith(TEXT("Resistance")))
+		{
+			// The limits are independent attributes, so the emotional resistances can only be checked for consistent limits.
+			if ((AttributeSet.GetMinEmotionalResistance() <= AttributeSet.GetMaxEmotionalResistance()) &&
+				((Value < AttributeSet.GetMinEmotionalResistance()) || (Value > AttributeSet.GetMaxEmotionalResistance())))
+			{
+				AddViolation(Attribute, Value, TEXT("a value in [MinEmotionalResistance, MaxEmotionalResistance]"));
+			}
+		}
+		else if (Attribute.AttributeName.EndsWith(TEXT("DamageMultiplier")))
+		{
+			if (Value < AttributeSet.GetMinEmotionalDamageMultiplier())
+			{
+				AddViolation(Attribute, Value, TEXT("a value >= MinEmotionalDamageMultiplier"));
+			}
+		}
+	}
+}
+
+float UPLDamageBenchmarkCommandlet::DrawFuzzValue(FRandomStream &RandomStream)
+{
+	static constexpr float ExtremeValues[]{0.0f, 1.0f, -1.0f, UE_SMALL_NUMBER, -UE_SMALL_NUMBER, UE_BIG_NUMBER, -UE_BIG_NUMBER, TNumericLimits<float>::Max(), TNumericLimits<float>::Lowest()};
+
+	const float Selector = RandomStream.GetFraction();
+	if (Selector < 0.1f)
+	{
+		return ExtremeValues[RandomStream.RandHelper(UE_ARRAY_COUNT(ExtremeValues))];
+	}
+	else if (Selector < 0.6f)
+	{
+		// gameplay range of multipliers and resistances
+		return RandomStream.FRandRange(-0.5f, 1.5f);
+	}
+	else
+	{
+		return RandomStream.FRandRange(-10000.0f, 10000.0f);
+	}
+}
@@ -0,0 +1,216 @@
+// Copyright TinyAlmonds (Alex Noerdemann)
+
+#include "Core/Benchmark/PLMemoryReport.h"
+
+#include "Abilities/GameplayAbility.h"
+#include "AbilitySystemComponent.h"
+#include "AttributeSet.h"
+#include "Dom/JsonObject.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "Serialization/ArchiveCountMem.h"
+
+#include "Core/AbilitySystem/PLAbilitySystemComponent.h"
+#include "Core/PLCharacter.h"
+#include "Core/PLEnemyCharacterBase.h"
+#include "Core/Subsystem/PLEnemyDirectorSubsystem.h"
+#include "Core/Subsystem/PLHitchDetectorSubsystem.h"
+#include "Core/Subsystem/PLLocalPlayersSubsystem.h"
+#include "Core/Subsystem/PLSplineLookupSubsystem.h"
+#include "Core/Subsystem/PLWallProximitySubsystem.h"
+
+namespace
+{
+	/**
+	 * Returns the memory of the given object like "obj list" does: the size of its class and the memory counted by the serialization of its properties.
+	 * @param Object - The object to measure.
+	 * @return The size of the object [bytes].
+	 */
+	int64 GetObjectBytes(const UObject &Object)
+	{
+		const FArchiveCountMem CountMem{const_cast<UObject *>(&Object)};
+		return static_cast<int64>(Object.GetClass()->GetStructureSize()) + static_cast<int64>(CountMem.GetMax());
+	}
+
+	/** Converts the given bytes to KiB. */
+	double ToKiB(int64 Bytes)
+	{
+		return static_cast<double>(Bytes) / 1024.0;
+	}
+
+	/** Formats the parts of the given footprint into a line of text. */
+	FString FormatFootprint(const FPLCharacterMemoryFootprint &Footprint)
+	{
+		return FString::Printf(TEXT("%.1f KiB (actor %.1f, ability system %.1f, attribute sets %.1f, ability instances %.1f, caches %.1f KiB; %d specs, %d effects)"),
+							   ToKiB(Footprint.GetTotalBytes()), ToKiB(Footprint.ActorBytes), ToKiB(Footprint.AbilitySystemBytes), ToKiB(Footprint.AttributeSetBytes),
+							   ToKiB(Footprint.AbilityInstanceBytes), ToKiB(Footprint.CacheBytes), Footprint.NumAbilitySpecs, Footprint.NumGameplayEffects);
+	}
+}
+
+FPLCharacterMemoryFootprint FPLCharacterMemoryFootprint::Measure(const AActor &Character, const UAbilitySystemComponent *AbilitySystemComponent)
+{
+	FPLCharacterMemoryFootprint Footprint{};
+	Footprint.ActorBytes = GetObjectBytes(Character);
+	TInlineComponentArray<UActorComponent *> Components{&Character};
+	for (const UActorComponent *Component : Components)
+	{
+		if (Component && (Component != AbilitySystemComponent))
+		{
+			Footprint.ActorBytes += GetObjectBytes(*Component);
+		}
+	}
+
+	if (!AbilitySystemComponent)
+	{
+		return Footprint;
+	}
+
+	// the specs and the active GameplayEffects are properties of the ability system and thereby counted with it
+	Footprint.AbilitySystemBytes = GetObjectBytes(*AbilitySystemComponent);
+	Footprint.NumAbilitySpecs = AbilitySystemComponent->GetActivatableAbilities().Num();
+	Footprint.NumGameplayEffects = AbilitySystemComponent->GetNumActiveGameplayEffects();
+
+	for (const UAttributeSet *AttributeSet : AbilitySystemComponent->GetSpawnedAttributes())
+	{
+		if (AttributeSet)
+		{
+			Footprint.AttributeSetBytes += GetObjectBytes(*AttributeSet);
+		}
+	}
+
+	for (const FGameplayAbilitySpec &AbilitySpec : AbilitySystemComponent->GetActivatableAbilities())
+	{
+		for (const UGameplayAbility *AbilityInstance : AbilitySpec.GetAbilityInstances())
+		{
+			if (AbilityInstance)
+			{
+				Footprint.AbilityInstanceBytes += GetObjectBytes(*AbilityInstance);
+			}
+		}
+	}
+
+	if (const UPLAbilitySystemComponent *PLAbilitySystemComponent = Cast<UPLAbilitySystemComponent>(AbilitySystemComponent); PLAbilitySystemComponent)
+	{
+		Footprint.CacheBytes = static_cast<int64>(PLAbilitySystemComponent->GetCacheAllocatedSize());
+	}
+
+	return Footprint;
+}
+
+int64 FPLCharacterMemoryFootprint::GetTotalBytes() const
+{
+	return ActorBytes + AbilitySystemBytes + AttributeSetBytes + AbilityInstanceBytes + CacheBytes;
+}
+
+FPLCharacterMemoryFootprint &FPLCharacterMemoryFootprint::operator+=(const FPLCharacterMemoryFootprint &Other)
+{
+	ActorBytes += Other.ActorBytes;
+	AbilitySystemBytes += Other.AbilitySystemBytes;
+	AttributeSetBytes += Other.AttributeSetBytes;
+	AbilityInstanceBytes += Other.AbilityInstanceBytes;
+	CacheBytes += Other.CacheBytes;
+	NumAbilitySpecs += Other.NumAbilitySpecs;
+	NumGameplayEffects += Other.NumGameplayEffects;
+	return *this;
+}
+
+TSharedRef<FJsonObject> FPLCharacterMemoryFootprint::ToJson() const
+{
+	TSharedRef<FJsonObject> Result = MakeShared<FJsonObject>();
+	Result->SetNumberField(TEXT("actorBytes"), static_cast<double>(ActorBytes));
+	Result->SetNumberField(TEXT("abilitySystemBytes"), static_cast<double>(AbilitySystemBytes));
+	Result->SetNumberField(TEXT("attributeSetBytes"), static_cast<double>(AttributeSetBytes));
+	Result->SetNumberField(TEXT("abilityInstanceBytes"), static_cast<double>(AbilityInstanceBytes));
+	Result->SetNumberField(TEXT("cacheBytes"), static_cast<double>(CacheBytes));
+	Result->SetNumberField(TEXT("totalBytes"), static_cast<double>(GetTotalBytes()));
+	Result->SetNumberField(TEXT("abilitySpecs"), NumAbilitySpecs);
+	Result->SetNumberField(TEXT("gameplayEffects"), NumGameplayEffects);
+	return Result;
+}
+
+FPLMemoryReport FPLMemoryReport::Gather(UWorld &World)
+{
+	FPLMemoryReport Report{};
+
+	for (TActorIterator<APLCharacter> CharacterIt{&World}; CharacterIt; ++CharacterIt)
+	{
+		Report.Characters += FPLCharacterMemoryFootprint::Measure(**CharacterIt, CharacterIt->GetAbilitySystemComponent());
+		++Report.NumCharacters;
+	}
+
+	TMap<const UClass *, FPLEnemyClassFootprint> EnemyClasses{};
+	for (TActorIterator<APLEnemyCharacterBase> EnemyIt{&World}; EnemyIt; ++EnemyIt)
+	{
+		const FPLCharacterMemoryFootprint Footprint{FPLCharacterMemoryFootprint::Measure(**EnemyIt, EnemyIt->GetAbilitySystemComponent())};
+		Report.Enemies += Footprint;
+		++Report.NumEnemies;
+
+		FPLEnemyClassFootprint &EnemyClass = EnemyClasses.FindOrAdd(EnemyIt->GetClass());
+		EnemyClass.ClassName = EnemyIt->GetClass()->GetName();
+		EnemyClass.Total += Footprint;
+		EnemyClass.MaxEnemyBytes = FMath::Max(EnemyClass.MaxEnemyBytes, Footprint.GetTotalBytes());
+		++EnemyClass.NumEnemies;
+	}
+	EnemyClasses.GenerateValueArray(Report.EnemyClasses);
+	Report.EnemyClasses.Sort([](const FPLEnemyClassFootprint &A, const FPLEnemyClassFootprint &B)
+							 { return A.Total.GetTotalBytes() > B.Total.GetTotalBytes(); });
+
+	if (const UPLSplineLookupSubsystem *SplineLookupSubsystem = World.GetSubsystem<UPLSplineLookupSubsystem>(); SplineLookupSubsystem)
+	{
+		Report.Caches.Emplace(TEXT("SplineLookup"), static_cast<int64>(SplineLookupSubsystem->GetAllocatedSize()));
+	}
+	if (const UPLWallProximitySubsystem *WallProximitySubsystem = World.GetSubsystem<UPLWallProximitySubsystem>(); WallProximitySubsystem)
+	{
+		Report.Caches.Emplace(TEXT("WallProximity"), static_cast<int64>(WallProximitySubsystem->GetAllocatedSize()));
+	}
+	if (const UPLEnemyDirectorSubsystem *EnemyDirectorSubsystem = World.GetSubsystem<UPLEnemyDirectorSubsystem>(); EnemyDirectorSubsystem)
+	{
+		Report.Caches.Emplace(TEXT("EnemyDirector"), static_cast<int64>(EnemyDirectorSubsystem->GetAllocatedSize()));
+	}
+	if (const UPLLocalPlayersSubsystem *LocalPlayersSubsystem = World.GetSubsystem<UPLLocalPlayersSubsystem>(); LocalPlayersSubsystem)
+	{
+		Report.Caches.Emplace(TEXT("LocalPlayers"), static_cast<int64>(LocalPlayersSubsystem->GetAllocatedSize()));
+	}
+	if (const UPLHitchDetectorSubsystem *HitchDetectorSubsystem = GEngine ? GEngine->GetEngineSubsystem<UPLHitchDetectorSubsystem>() : nullptr; HitchDetectorSubsystem)
+	{
+		Report.Caches.Emplace(TEXT("HitchDetector"), static_cast<int64>(HitchDetectorSubsystem->GetAllocatedSize()));
+	}
+
+	return Report;
+}
+
+int64 FPLMemoryReport::GetCacheBytes() const
+{
+	int64 CacheBytes{0};
+	for (const TPair<FString, int64> &Cache : Caches)
+	{
+		CacheBytes += Cache.Value;
+	}
+
+	return CacheBytes;
+}
+
+int64 FPLMemoryReport::GetTotalBytes() const
+{
+	return Characters.GetTotalBytes() + Enemies.GetTotalBytes() + GetCacheBytes();
+}
+
+TArray<FString> FPLMemoryReport::ToLines() const
+{
+	TArray<FString> Lines{};
+	Lines.Add(FString::Printf(TEXT("Characters: %d, %s"), NumCharacters, *FormatFootprint(Characters)));
+	Lines.Add(FString::Printf(TEXT("Enemies: %d, %s"), NumEnemies, *FormatFootprint(Enemies)));
+	for (const FPLEnemyClassFootprint &EnemyClass : EnemyClasses)
+	{
+		Lines.Add(FString::Printf(TEXT("  %s: %d, %.1f KiB per enemy (max %.1f KiB), %.1f KiB in total"), *EnemyClass.ClassName, EnemyClass.NumEnemies,
+								  ToKiB(EnemyClass.Total.GetTotalBytes() / FMath::Max(EnemyClass.NumEnemies, 1)), ToKiB(EnemyClass.MaxEnemyBytes), ToKiB(EnemyClass.Total.GetTotalBytes())));
+	}
+	Lines.Add(FString::Printf(TEXT("Caches: %.1f KiB"), ToKiB(GetCacheBytes())));
+	for (const TPair<FString, int64> &Cache : Caches)
+	{
+		Lines.Add(FString::Printf(TEXT("  %s: %.1f KiB"), *Cache.Key, ToKiB(Cache.Value)));
+	}
+	Lines.Add(FString::Printf(TEXT("Total: %.1f KiB"), ToKiB(GetTotalBytes())));
+	return Lines;
+}
@@ -0,0 +1,9 @@
+// Copyright TinyAlmonds (Alex Noerdemann)
+
+#include "Core/Benchmark/PLMemoryTags.h"
+
+LLM_DEFINE_TAG(ProjectLux);
+LLM_DEFINE_TAG(ProjectLux_Character, TEXT("Character"), TEXT("ProjectLux"));
+LLM_DEFINE_TAG(ProjectLux_Enemies, TEXT("Enemies"), TEXT("ProjectLux"));
+LLM_DEFINE_TAG(ProjectLux_AbilitySystem, TEXT("AbilitySystem"), TEXT("ProjectLux"));
+LLM_DEFINE_TAG(ProjectLux_Caches, TEXT("Caches"), TEXT("ProjectLux"));
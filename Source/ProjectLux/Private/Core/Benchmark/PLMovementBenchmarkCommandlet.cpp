@@ -0,0 +1,276 @@
+// Copyright TinyAlmonds (Alex Noerdemann)
+
+#include "Core/Benchmark/PLMovementBenchmarkCommandlet.h"
+
+#include "AbilitySystemComponent.h"
+#include "Algo/AllOf.h"
+#include "Components/SplineComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Dom/JsonObject.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/World.h"
+#include "GameFramework/GameModeBase.h"
+#include "GameMapsSettings.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/Parse.h"
+
+#include "Core/AbilitySystem/PLGameplayTags.h"
+#include "Core/Benchmark/PLBenchmarkUtils.h"
+#include "Core/PLCharacter.h"
+#include "Core/PLEnemyCharacterBase.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogPLMovementBenchmark, Log, All);
+
+UPLMovementBenchmarkCommandlet::UPLMovementBenchmarkCommandlet() : BenchmarkSpline{nullptr}
+{
+	IsClient = false;
+	IsEditor = false;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UPLMovementBenchmarkCommandlet::Main(const FString &Params)
+{
+	int32 NumCharacters{8};
+	int32 NumEnemies{32};
+	int32 NumFrames{600};
+	int32 NumWarmupFrames{60};
+	float DeltaTime{1.0f / 60.0f};
+	FString CharacterClassPath{};
+	FString EnemyClassPath{};
+	FString OutputFilePath{};
+	FParse::Value(*Params, TEXT("NumCharacters="), NumCharacters);
+	FParse::Value(*Params, TEXT("NumEnemies="), NumEnemies);
+	FParse::Value(*Params, TEXT("Frames="), NumFrames);
+	FParse::Value(*Params, TEXT("WarmupFrames="), NumWarmupFrames);
+	FParse::Value(*Params, TEXT("DeltaTime="), DeltaTime);
+	FParse::Value(*Params, TEXT("CharacterClass="), CharacterClassPath);
+	FParse::Value(*Params, TEXT("EnemyClass="), EnemyClassPath);
+	FParse::Value(*Params, TEXT("Output="), OutputFilePath);
+
+	// the native character has no abilities, so the character of the game is used by default
+	UClass *CharacterClass = CharacterClassPath.IsEmpty() ? FindDefaultCharacterClass() : LoadClass<APLCharacter>(nullptr, *CharacterClassPath);
+	UClass *EnemyClass = EnemyClassPath.IsEmpty() ? APLEnemyCharacterBase::StaticClass() : LoadClass<APLEnemyCharacterBase>(nullptr, *EnemyClassPath);
+	if (!CharacterClass || !EnemyClass)
+	{
+		UE_LOG(LogPLMovementBenchmark, Error, TEXT("Could not load the character class '%s' or enemy class '%s'."), *CharacterClassPath, *EnemyClassPath);
+		return 1;
+	}
+
+	UWorld *World = CreateBenchmarkWorld();
+
+	// spawn the characters in lanes along the X axis, each facing the walls along the Y axis
+	FActorSpawnParameters SpawnParameters{};
+	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	TArray<APLCharacter *> Characters{};
+	for (int32 CharacterIndex = 0; CharacterIndex < NumCharacters; ++CharacterIndex)
+	{
+		APLCharacter *Character = World->SpawnActor<APLCharacter>(CharacterClass, FVector{300.0 * CharacterIndex, 0.0, 200.0}, FRotator::ZeroRotator, SpawnParameters);
+		if (Character)
+		{
+			Character->SpawnDefaultController();
+			Characters.Add(Character);
+		}
+	}
+
+	TArray<APLEnemyCharacterBase *> Enemies{};
+	for (int32 EnemyIndex = 0; EnemyIndex < NumEnemies; ++EnemyIndex)
+	{
+		const FVector EnemyLocation{-300.0 - 200.0 * (EnemyIndex / 8), -700.0 + 200.0 * (EnemyIndex % 8), 200.0};
+		APLEnemyCharacterBase *Enemy = World->SpawnActor<APLEnemyCharacterBase>(EnemyClass, EnemyLocation, FRotator::ZeroRotator, SpawnParameters);
+		if (Enemy)
+		{
+			Enemy->SpawnDefaultController();
+			Enemies.Add(Enemy);
+		}
+	}
+
+	UE_LOG(LogPLMovementBenchmark, Display, TEXT("Running %d frames (+%d warmup) with %d characters and %d enemies."), NumFrames, NumWarmupFrames, Characters.Num(), Enemies.Num());
+
+	// without the abilities the dash, glide and wall slide inputs do nothing, which would silently report the cost of walking only
+	const bool bAbilitiesCovered{!Characters.IsEmpty() && Algo::AllOf(Characters, [](const APLCharacter *Character)
+																	 { return HasScriptedAbilities(*Character); })};
+	if (!bAbilitiesCovered)
+	{
+		UE_LOG(LogPLMovementBenchmark, Warning, TEXT("The characters of the class '%s' miss the Dash, Glide or WallSlide ability. These stages are not covered by the benchmark."), *CharacterClass->GetPathName());
+	}
+
+	TArray<double> FrameTimesMs{};
+	TArray<double> AllocationsPerFrame{};
+	TArray<double> AllocatedBytesPerFrame{};
+	FrameTimesMs.Reserve(NumFrames);
+	AllocationsPerFrame.Reserve(NumFrames);
+	AllocatedBytesPerFrame.Reserve(NumFrames);
+
+	int32 CharacterFramesPerMovementSpace[3]{0, 0, 0};
+	int32 CharacterFramesWallSliding{0};
+	{
+		FPLScopedAllocationCounter AllocationCounter{};
+		for (int32 Frame = 0; Frame < NumWarmupFrames + NumFrames; ++Frame)
+		{
+			AllocationCounter.Reset();
+			const uint64 FrameStartCycles = FPlatformTime::Cycles64();
+
+			for (int32 CharacterIndex = 0; CharacterIndex < Characters.Num(); ++CharacterIndex)
+			{
+				ApplyScriptedInput(Characters[CharacterIndex], CharacterIndex, Frame);
+			}
+			World->Tick(LEVELTICK_All, DeltaTime);
+
+			const uint64 FrameEndCycles = FPlatformTime::Cycles64();
+			++GFrameCounter;
+
+			if (Frame >= NumWarmupFrames)
+			{
+				FrameTimesMs.Add(FPlatformTime::ToMilliseconds64(FrameEndCycles - FrameStartCycles));
+				AllocationsPerFrame.Add(static_cast<double>(AllocationCounter.GetNumAllocations()));
+				AllocatedBytesPerFrame.Add(static_cast<double>(AllocationCounter.GetNumAllocatedBytes()));
+
+				for (const APLCharacter *Character : Characters)
+				{
+					++CharacterFramesPerMovementSpace[static_cast<int32>(Character->GetMovementSpaceState())];
+					CharacterFramesWallSliding += Character->GetWallSlidingFlag() ? 1 : 0;
+				}
+			}
+		}
+	}
+
+	TSharedRef<FJsonObject> Result = MakeShared<FJsonObject>();
+	Result->SetStringField(TEXT("benchmark"), TEXT("movement"));
+	Result->SetStringField(TEXT("characterClass"), CharacterClass->GetPathName());
+	Result->SetStringField(TEXT("enemyClass"), EnemyClass->GetPathName());
+	Result->SetNumberField(TEXT("numCharacters"), Characters.Num());
+	Result->SetNumberField(TEXT("numEnemies"), Enemies.Num());
+	Result->SetNumberField(TEXT("frames"), NumFrames);
+	Result->SetNumberField(TEXT("deltaTime"), DeltaTime);
+	Result->SetObjectField(TEXT("frameTimeMs"), FPLBenchmarkSampleStatistics::FromSamples(FrameTimesMs).ToJson());
+	Result->SetObjectField(TEXT("allocationsPerFrame"), FPLBenchmarkSampleStatistics::FromSamples(AllocationsPerFrame).ToJson());
+	Result->SetObjectField(TEXT("allocatedBytesPerFrame"), FPLBenchmarkSampleStatistics::FromSamples(AllocatedBytesPerFrame).ToJson());
+
+	// coverage of the scripted input, so that a benchmark run which e.g. never wall slides is noticed
+	TSharedRef<FJsonObject> Coverage = MakeShared<FJsonObject>();
+	Coverage->SetNumberField(TEXT("characterFramesIn2D"), CharacterFramesPerMovementSpace[static_cast<int32>(EPLMovementSpaceState::MovementIn2D)]);
+	Coverage->SetNumberField(TEXT("characterFramesIn3D"), CharacterFramesPerMovementSpace[static_cast<int32>(EPLMovementSpaceState::MovementIn3D)]);
+	Coverage->SetNumberField(TEXT("characterFramesOnSpline"), CharacterFramesPerMovementSpace[static_cast<int32>(EPLMovementSpaceState::MovementOnSpline)]);
+	Coverage->SetNumberField(TEXT("characterFramesWallSliding"), CharacterFramesWallSliding);
+	Coverage->SetBoolField(TEXT("abilitiesCovered"), bAbilitiesCovered);
+	Result->SetObjectField(TEXT("coverage"), Coverage);
+
+	const bool bResultWritten = PLBenchmarkUtils::WriteResult(Result, OutputFilePath, TEXT("MovementBenchmark"));
+
+	PLBenchmarkUtils::DestroyWorld(World);
+
+	return bResultWritten ? 0 : 1;
+}
+
+UWorld *UPLMovementBenchmarkCommandlet::CreateBenchmarkWorld()
+{
+	UWorld *World = PLBenchmarkUtils::CreateWorld(TEXT("PLMovementBenchmarkWorld"));
+
+	// floor and the walls to slide on, which are placed along the Y axis in front of the character lanes
+	SpawnBlockingCube(World, FVector{0.0, 0.0, -50.0}, FVector{100.0, 20.0, 1.0}, false);
+	SpawnBlockingCube(World, FVector{0.0, 750.0, 500.0}, FVector{100.0, 1.0, 10.0}, true);
+	SpawnBlockingCube(World, FVector{0.0, -750.0, 500.0}, FVector{100.0, 1.0, 10.0}, true);
+
+	// spline for the EPLMovementSpaceState::MovementOnSpline state
+	AActor *SplineActor = World->SpawnActor<AActor>();
+	BenchmarkSpline = NewObject<USplineComponent>(SplineActor, TEXT("BenchmarkSpline"));
+	SplineActor->SetRootComponent(BenchmarkSpline);
+	BenchmarkSpline->RegisterComponent();
+	BenchmarkSpline->SetSplinePoints(TArray<FVector>{FVector{0.0, -650.0, 0.0}, FVector{250.0, -200.0, 0.0}, FVector{250.0, 200.0, 0.0}, FVector{0.0, 650.0, 0.0}}, ESplineCoordinateSpace::World);
+
+	return World;
+}
+
+void UPLMovementBenchmarkCommandlet::SpawnBlockingCube(UWorld *World, const FVector &Location, const FVector &Scale, bool bWallSlidable)
+{
+	static UStaticMesh *CubeMesh = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+
+	AStaticMeshActor *CubeActor = World->SpawnActor<AStaticMeshActor>(Location, FRotator::ZeroRotator);
+	if (CubeActor)
+	{
+		UStaticMeshComponent *CubeMeshComponent = CubeActor->GetStaticMeshComponent();
+		CubeMeshComponent->SetStaticMesh(CubeMesh);
+		CubeMeshComponent->SetCollisionProfileName(UCollisionProfile::BlockAll_ProfileName);
+		CubeMeshComponent->SetCollisionResponseToChannel(ECollisionChannel::ECC_GameTraceChannel1, bWallSlidable ? ECR_Block : ECR_Ignore); // Wallslide Trace Channel
+		CubeActor->SetActorScale3D(Scale);
+	}
+}
+
+void UPLMovementBenchmarkCommandlet::ApplyScriptedInput(APLCharacter *Character, int32 CharacterIndex, int32 Frame) const
+{
+	// Each phase uses another movement space. Within a phase the character runs towards a wall, jumps, dashes, glides and slides down the wall.
+	static constexpr int32 FramesPerRun{60};
+	const int32 Phase = (Frame / FramesPerMovementSpacePhase) % 3;
+	const int32 FrameInPhase = Frame % FramesPerMovementSpacePhase;
+	const int32 FrameInRun = (FrameInPhase + 7 * CharacterIndex) % FramesPerRun;
+
+	if (FrameInPhase == 0)
+	{
+		FPLMovementSpaceTransition Transition{};
+		Transition.MovementSpace = static_cast<EPLMovementSpaceState>(Phase);
+		Transition.MovementSpline = BenchmarkSpline;
+		Character->ApplyMovementSpaceTransition(Transition);
+	}
+
+	const float RunDirection = ((FrameInPhase / FramesPerRun) % 2 == 0) ? 1.0f : -1.0f;
+	Character->MoveRight(RunDirection);
+	Character->MoveUp((Character->GetMovementSpaceState() == EPLMovementSpaceState::MovementIn3D) ? FMath::Sin(0.1f * Frame) : 0.0f);
+
+	switch (FrameInRun)
+	{
+	case 5:
+		Character->JumpPress();
+		break;
+	case 15:
+		Character->DashPress();
+		break;
+	case 25:
+		Character->JumpRelease();
+		break;
+	case 30:
+		Character->GlidePress();
+		break;
+	case 45:
+		Character->TryCancelGlideAbility();
+		break;
+	default:
+		break;
+	}
+}
+
+UClass *UPLMovementBenchmarkCommandlet::FindDefaultCharacterClass()
+{
+	if (const UClass *GameModeClass = LoadClass<AGameModeBase>(nullptr, *UGameMapsSettings::GetGlobalDefaultGameMode()); GameModeClass)
+	{
+		if (UClass *DefaultPawnClass = GameModeClass->GetDefaultObject<AGameModeBase>()->DefaultPawnClass; DefaultPawnClass && DefaultPawnClass->IsChildOf<APLCharacter>())
+		{
+			return DefaultPawnClass;
+		}
+	}
+
+	return APLCharacter::StaticClass();
+}
+
+bool UPLMovementBenchmarkCommandlet::HasScriptedAbilities(const APLCharacter &Character)
+{
+	UAbilitySystemComponent *AbilitySystemComponent = Character.GetAbilitySystemComponent();
+	if (!AbilitySystemComponent)
+	{
+		return false;
+	}
+
+	for (const FGameplayTag &AbilityTag : {PLGameplayTags::Ability_Movement_Dash, PLGameplayTags::Ability_Movement_Glide, PLGameplayTags::Ability_Movement_WallSlide})
+	{
+		TArray<FGameplayAbilitySpec *> MatchingAbilitySpecs{};
+		AbilitySystemComponent->GetActivatableGameplayAbilitySpecsByAllMatchingTags(FGameplayTagContainer{AbilityTag}, MatchingAbilitySpecs);
+		if (MatchingAbilitySpecs.IsEmpty())
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
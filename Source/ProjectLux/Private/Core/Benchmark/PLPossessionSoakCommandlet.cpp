@@ -0,0 +1,123 @@
+// Copyright TinyAlmonds (Alex Noerdemann)
+
+#include "Core/Benchmark/PLPossessionSoakCommandlet.h"
+
+#include "AbilitySystemComponent.h"
+#include "AIController.h"
+#include "Dom/JsonObject.h"
+#include "Engine/World.h"
+#include "Misc/Parse.h"
+
+#include "Core/AbilitySystem/PLAbilitySystemDelegateBindings.h"
+#include "Core/AbilitySystem/PLCharacterAttributeSet.h"
+#include "Core/AbilitySystem/PLGameplayTags.h"
+#include "Core/Benchmark/PLBenchmarkUtils.h"
+#include "Core/Benchmark/PLMemoryReport.h"
+#include "Core/PLCharacter.h"
+#include "Core/PLEnemyCharacterBase.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogPLPossessionSoak, Log, All);
+
+UPLPossessionSoakCommandlet::UPLPossessionSoakCommandlet()
+{
+	IsClient = false;
+	IsEditor = false;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UPLPossessionSoakCommandlet::Main(const FString &Params)
+{
+	int32 NumCycles{5000};
+	FString OutputFilePath{};
+	FParse::Value(*Params, TEXT("Cycles="), NumCycles);
+	FParse::Value(*Params, TEXT("Output="), OutputFilePath);
+
+	UWorld *World = PLBenchmarkUtils::CreateWorld(TEXT("PLPossessionSoakWorld"));
+
+	FActorSpawnParameters SpawnParameters{};
+	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	APLCharacter *Character = World->SpawnActor<APLCharacter>(FVector{0.0, 0.0, 0.0}, FRotator::ZeroRotator, SpawnParameters);
+	APLEnemyCharacterBase *Enemy = World->SpawnActor<APLEnemyCharacterBase>(FVector{200.0, 0.0, 0.0}, FRotator::ZeroRotator, SpawnParameters);
+	AAIController *CharacterController = World->SpawnActor<AAIController>(SpawnParameters);
+	AAIController *EnemyController = World->SpawnActor<AAIController>(SpawnParameters);
+
+	TSharedRef<FJsonObject> Result = MakeShared<FJsonObject>();
+	Result->SetStringField(TEXT("benchmark"), TEXT("possessionSoak"));
+	Result->SetNumberField(TEXT("cycles"), NumCycles);
+
+	bool bBindingsFlat{false};
+	if (Character && Enemy && CharacterController && EnemyController)
+	{
+		const TSharedRef<FJsonObject> CharacterResult = SoakPossession(*Character, *Character->GetAbilitySystemComponent(), *CharacterController, Character->GetAbilitySystemDelegateBindings(), NumCycles);
+		const TSharedRef<FJsonObject> EnemyResult = SoakPossession(*Enemy, *Enemy->GetAbilitySystemComponent(), *EnemyController, Enemy->GetAbilitySystemDelegateBindings(), NumCycles);
+		bBindingsFlat = CharacterResult->GetBoolField(TEXT("flat")) && EnemyResult->GetBoolField(TEXT("flat"));
+
+		Result->SetObjectField(TEXT("character"), CharacterResult);
+		Result->SetObjectField(TEXT("enemy"), EnemyResult);
+	}
+	else
+	{
+		UE_LOG(LogPLPossessionSoak, Error, TEXT("Could not spawn the characters or controllers."));
+	}
+	Result->SetBoolField(TEXT("flat"), bBindingsFlat);
+
+	const bool bResultWritten = PLBenchmarkUtils::WriteResult(Result, OutputFilePath, TEXT("PossessionSoak"));
+
+	PLBenchmarkUtils::DestroyWorld(World);
+
+	if (!bBindingsFlat)
+	{
+		UE_LOG(LogPLPossessionSoak, Error, TEXT("The delegate bindings grew over the possession cycles."));
+	}
+
+	return (bResultWritten && bBindingsFlat) ? 0 : 1;
+}
+
+TSharedRef<FJsonObject> UPLPossessionSoakCommandlet::SoakPossession(ACharacter &Character, UAbilitySystemComponent &AbilitySystemComponent, AController &Controller, const FPLAbilitySystemDelegateBindings &Bindings, int32 NumCycles)
+{
+	FBindingCounts FirstCycleCounts{};
+	FBindingCounts LastCycleCounts{};
+	FPLCharacterMemoryFootprint FirstCycleFootprint{};
+	FPLCharacterMemoryFootprint LastCycleFootprint{};
+	for (int32 Cycle = 0; Cycle < NumCycles; ++Cycle)
+	{
+		Controller.Possess(&Character);
+		if (Cycle == 0)
+		{
+			FirstCycleCounts = GetBindingCounts(AbilitySystemComponent, Bindings);
+			FirstCycleFootprint = FPLCharacterMemoryFootprint::Measure(Character, &AbilitySystemComponent);
+		}
+		LastCycleCounts = GetBindingCounts(AbilitySystemComponent, Bindings);
+		if (Cycle == (NumCycles - 1))
+		{
+			LastCycleFootprint = FPLCharacterMemoryFootprint::Measure(Character, &AbilitySystemComponent);
+		}
+		Controller.UnPossess();
+	}
+
+	const int32 NumBindingsAfterUnpossession{Bindings.Num()};
+
+	TSharedRef<FJsonObject> Result = MakeShared<FJsonObject>();
+	Result->SetNumberField(TEXT("firstCycleBindings"), FirstCycleCounts.NumBindings);
+	Result->SetNumberField(TEXT("lastCycleBindings"), LastCycleCounts.NumBindings);
+	Result->SetNumberField(TEXT("firstCycleDelegateBytes"), static_cast<double>(FirstCycleCounts.DelegateAllocatedSize));
+	Result->SetNumberField(TEXT("lastCycleDelegateBytes"), static_cast<double>(LastCycleCounts.DelegateAllocatedSize));
+	Result->SetNumberField(TEXT("bindingsAfterUnpossession"), NumBindingsAfterUnpossession);
+
+	// the footprint is informational (e.g. to spot growing spec or effect containers), since the allocators may keep slack between the cycles
+	Result->SetObjectField(TEXT("firstCycleFootprint"), FirstCycleFootprint.ToJson());
+	Result->SetObjectField(TEXT("lastCycleFootprint"), LastCycleFootprint.ToJson());
+	Result->SetBoolField(TEXT("flat"), (FirstCycleCounts == LastCycleCounts) && (FirstCycleCounts.NumBindings > 0) && (NumBindingsAfterUnpossession == 0));
+	return Result;
+}
+
+UPLPossessionSoakCommandlet::FBindingCounts UPLPossessionSoakCommandlet::GetBindingCounts(UAbilitySystemComponent &AbilitySystemComponent, const FPLAbilitySystemDelegateBindings &Bindings)
+{
+	// duplicate bindings would grow the invocation lists of the observed delegates
+	FBindingCounts Counts{};
+	Counts.NumBindings = Bindings.Num();
+	Counts.DelegateAllocatedSize = AbilitySystemComponent.GetGameplayAttributeValueChangeDelegate(UPLCharacterAttributeSet::GetHealthAttribute()).GetAllocatedSize() +
+								   AbilitySystemComponent.RegisterGameplayTagEvent(PLGameplayTags::Status_Dead, EGameplayTagEventType::NewOrRemoved).GetAllocatedSize();
+	return Counts;
+}
@@ -0,0 +1,209 @@
+// Copyright TinyAlmonds (Alex Noerdemann)
+
+#include "Core/Component/CharacterMovement/PLCharacterMovementComponent.h"
+
+#include "AbilitySystemComponent.h"
+#include "AbilitySystemGlobals.h"
+#include "Components/SplineComponent.h"
+
+#include "Core/AbilitySystem/PLAbilitySystemComponent.h"
+#include "Core/AbilitySystem/PLMovementAttributeSet.h"
+#include "Core/Subsystem/PLHitchDetectorSubsystem.h"
+#include "Core/Subsystem/PLSplineLookupSubsystem.h"
+#include "Core/Types/PLSplineLookupTable.h"
+
+namespace
+{
+	/** Distance along the spline searched in both directions around the previous distance, when the distance is synchronized on the same spline [uu]. */
+	constexpr float SyncSplineSearchDistance{500.0f};
+}
+
+FVector UPLCharacterMovementComponent::NewFallVelocity(const FVector &InitialVelocity, const FVector &Gravity, float DeltaTime) const
+{
+	FVector FallVelocity{Super::NewFallVelocity(InitialVelocity, Gravity, DeltaTime)};
+
+	// limit negative z-velocity (for better falling/air control, etc.)
+	if (MovementAttributeSet && (FallVelocity.Z < 0.0f))
+	{
+		FallVelocity.Z = FMath::Max(FallVelocity.Z, MovementAttributeSet->GetMaxFallSpeed());
+	}
+
+	return FallVelocity;
+}
+
+void UPLCharacterMovementComponent::PushGravityScaleOverride(EPLGravityScaleOverrideSource Source, float OverrideGravityScale)
+{
+	GravityScaleOverrides.RemoveAll([Source](const FPLGravityScaleOverride &Override)
+									{ return Override.Source == Source; });
+	GravityScaleOverrides.Add(FPLGravityScaleOverride{Source, OverrideGravityScale});
+
+	ApplyGravityScaleOverrides();
+}
+
+void UPLCharacterMovementComponent::PopGravityScaleOverride(EPLGravityScaleOverrideSource Source, bool bApplyGravityScale)
+{
+	if ((GravityScaleOverrides.RemoveAll([Source](const FPLGravityScaleOverride &Override)
+										 { return Override.Source == Source; }) > 0) &&
+		bApplyGravityScale)
+	{
+		ApplyGravityScaleOverrides();
+	}
+}
+
+void UPLCharacterMovementComponent::ResetGravityScaleOverrides()
+{
+	GravityScaleOverrides.Reset();
+	ApplyGravityScaleOverrides();
+}
+
+bool UPLCharacterMovementComponent::HasGravityScaleOverride(EPLGravityScaleOverrideSource Source) const
+{
+	return GravityScaleOverrides.ContainsByPredicate([Source](const FPLGravityScaleOverride &Override)
+													 { return Override.Source == Source; });
+}
+
+float UPLCharacterMovementComponent::GetDefaultGravityScale() const
+{
+	return DefaultGravityScale;
+}
+
+void UPLCharacterMovementComponent::SetMovementSpline(const USplineComponent *Spline)
+{
+	const bool bSameSpline{Spline && (Spline == MovementSpline)};
+	MovementSpline = Spline;
+	SyncMovementSplineDistance(bSameSpline);
+}
+
+FVector UPLCharacterMovementComponent::GetMovementSplineDirection() const
+{
+	if (MovementSpline)
+	{
+		const FPLSplineLookupTable *LookupTable = GetMovementSplineLookupTable();
+		FVector SplineDirection{LookupTable ? LookupTable->GetDirectionAtDistance(MovementSplineDistance, MovementSpline->GetComponentTransform())
+										  : MovementSpline->GetDirectionAtDistanceAlongSpline(MovementSplineDistance, ESplineCoordinateSpace::World)};
+		SplineDirection.Z = 0.0f;
+		return SplineDirection.GetSafeNormal();
+	}
+
+	return FVector::ZeroVector;
+}
+
+float UPLCharacterMovementComponent::GetMovementSplineDistance() const
+{
+	return MovementSplineDistance;
+}
+
+void UPLCharacterMovementComponent::OnTeleported()
+{
+	Super::OnTeleported();
+
+	SyncMovementSplineDistance(true);
+}
+
+void UPLCharacterMovementComponent::InitializeComponent()
+{
+	Super::InitializeComponent();
+
+	DefaultGravityScale = GravityScale;
+}
+
+void UPLCharacterMovementComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction *ThisTickFunction)
+{
+	PL_SCOPE_HITCH_STAGE(CharacterMovement);
+
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+}
+
+void UPLCharacterMovementComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (UAbilitySystemComponent *OwnerAbilitySystemComponent{UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(GetOwner())}; OwnerAbilitySystemComponent)
+	{
+		AbilitySystemComponent = Cast<UPLAbilitySystemComponent>(OwnerAbilitySystemComponent);
+		MovementAttributeSet = OwnerAbilitySystemComponent->GetSet<UPLMovementAttributeSet>();
+	}
+}
+
+bool UPLCharacterMovementComponent::MoveUpdatedComponentImpl(const FVector &Delta, const FQuat &NewRotation, bool bSweep, FHitResult *OutHit, ETeleportType Teleport)
+{
+	if (!MovementSpline || !UpdatedComponent || (Teleport != ETeleportType::None))
+	{
+		return Super::MoveUpdatedComponentImpl(Delta, NewRotation, bSweep, OutHit, Teleport);
+	}
+
+	// only the part of the horizontal move along the spline tangent advances the character, the z-direction is free
+	const float SplineStep{static_cast<float>(FVector::DotProduct(FVector{Delta.X, Delta.Y, 0.0f}, GetMovementSplineDirection()))};
+	const float TargetSplineDistance{NormalizeMovementSplineDistance(MovementSplineDistance + SplineStep)};
+	const FPLSplineLookupTable *LookupTable = GetMovementSplineLookupTable();
+	const FVector TargetLocationOnSpline{LookupTable ? LookupTable->GetLocationAtDistance(TargetSplineDistance, MovementSpline->GetComponentTransform())
+													 : MovementSpline->GetLocationAtDistanceAlongSpline(TargetSplineDistance, ESplineCoordinateSpace::World)};
+	const FVector CurrentLocation{UpdatedComponent->GetComponentLocation()};
+	const FVector ConstrainedDelta{TargetLocationOnSpline.X - CurrentLocation.X, TargetLocationOnSpline.Y - CurrentLocation.Y, Delta.Z};
+
+	FHitResult LocalHit{};
+	FHitResult *MoveHit = OutHit ? OutHit : &LocalHit;
+	const bool bMoved{Super::MoveUpdatedComponentImpl(ConstrainedDelta, NewRotation, bSweep, MoveHit, Teleport)};
+
+	// a blocked sweep only covers a part of the step
+	MovementSplineDistance = NormalizeMovementSplineDistance(MovementSplineDistance + (MoveHit->bBlockingHit ? (SplineStep * MoveHit->Time) : SplineStep));
+
+	return bMoved;
+}
+
+void UPLCharacterMovementComponent::ProcessLanded(const FHitResult &Hit, float RemainingTime, int32 Iterations)
+{
+	Super::ProcessLanded(Hit, RemainingTime, Iterations);
+
+	if (AbilitySystemComponent)
+	{
+		AbilitySystemComponent->NotifyLanded();
+	}
+}
+
+void UPLCharacterMovementComponent::SyncMovementSplineDistance(bool bSearchAroundPreviousDistance)
+{
+	if (MovementSpline && UpdatedComponent)
+	{
+		// we only want to find the closest location on the spline in the XY plane, since the character can move freely in the z-direction
+		const FVector Location{UpdatedComponent->GetComponentLocation()};
+		if (const FPLSplineLookupTable *LookupTable = GetMovementSplineLookupTable(); LookupTable)
+		{
+			// the windowed search falls back to the whole spline, if the closest location lies on the border of the searched part
+			const FVector PlaneLocation{Location.X, Location.Y, 0.0f};
+			MovementSplineDistance = bSearchAroundPreviousDistance ? LookupTable->FindDistanceClosestToLocation(PlaneLocation, MovementSpline->GetComponentTransform(), MovementSplineDistance, SyncSplineSearchDistance)
+																   : LookupTable->FindDistanceClosestToLocation(PlaneLocation, MovementSpline->GetComponentTransform());
+		}
+		else
+		{
+			const float InputKey{MovementSpline->FindInputKeyClosestToWorldLocation(FVector{Location.X, Location.Y, 0.0f})};
+			MovementSplineDistance = MovementSpline->GetDistanceAlongSplineAtSplineInputKey(InputKey);
+		}
+	}
+	else
+	{
+		MovementSplineDistance = 0.0f;
+	}
+}
+
+const FPLSplineLookupTable *UPLCharacterMovementComponent::GetMovementSplineLookupTable() const
+{
+	return UPLSplineLookupSubsystem::AreLookupTablesEnabled() ? UPLSplineLookupSubsystem::FindLookupTableOfSpline(MovementSpline) : nullptr;
+}
+
+float UPLCharacterMovementComponent::NormalizeMovementSplineDistance(float Distance) const
+{
+	const float SplineLength{MovementSpline->GetSplineLength()};
+	if (MovementSpline->IsClosedLoop() && (SplineLength > 0.0f))
+	{
+		const float WrappedDistance{FMath::Fmod(Distance, SplineLength)};
+		return (WrappedDistance < 0.0f) ? (WrappedDistance + SplineLength) : WrappedDistance;
+	}
+
+	return FMath::Clamp(Distance, 0.0f, SplineLength);
+}
+
+void UPLCharacterMovementComponent::ApplyGravityScaleOverrides()
+{
+	GravityScale = GravityScaleOverrides.IsEmpty() ? DefaultGravityScale : GravityScaleOverrides.Last().GravityScale;
+}
@@ -2,7 +2,13 @@
 #include "Core/Component/ChaseActorAlongSpline/PLChaseActorAlongSplineComponent.h"
 
 #include "Components/SplineComponent.h"
+#include "Algo/BinarySearch.h"
 #include "Kismet/GameplayStatics.h"
+#include "UObject/ObjectSaveContext.h"
+
+#include "Core/Subsystem/PLHitchDetectorSubsystem.h"
+#include "Core/Subsystem/PLLocalPlayersSubsystem.h"
+#include "Core/Subsystem/PLSplineLookupSubsystem.h"
 
 UPLChaseActorAlongSplineComponent::UPLChaseActorAlongSplineComponent()
 {
@@ -11,6 +17,8 @@ UPLChaseActorAlongSplineComponent::UPLChaseActorAlongSplineComponent()
 
 void UPLChaseActorAlongSplineComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction *ThisTickFunction)
 {
+	PL_SCOPE_HITCH_STAGE(ChaseUpdate);
+
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
 	// We have to query the player on every tick, since the player can die and therefore the actor changes.
@@ -18,6 +26,13 @@ void UPLChaseActorAlongSplineComponent::TickComponent(float DeltaTime, ELevelTic
 	{
 		SetChaseActorForPlayerActorMode();
 	}
+	else if (ChaseActorSettings.ActorMode == EPLChaseActorAlongSplineActorMode::NearestPlayer)
+	{
+		SetChaseActorForNearestPlayerActorMode();
+	}
+
+	// the baked tables can be disabled at runtime, so that they can be compared with the direct spline queries
+	const FPLSplineLookupTable *ChaseLookupTable = GetChaseSplineLookupTable();
 
 	AActor *OwnerActor = GetOwner();
 	switch (ChaseActorSettings.ChaseMode)
@@ -26,18 +41,37 @@ void UPLChaseActorAlongSplineComponent::TickComponent(float DeltaTime, ELevelTic
 		if (IsValid(OwnerActor) && ChaseActorSettings.ActorToChase.IsValid(false, false) && SplineToChaseAlong.IsValid(false, false))
 		{
 			const FVector CurrentClosestPointOnChaseSpline = OwnerActor->GetActorLocation();
-			const FVector NewClosestPointOnChaseSpline = SplineToChaseAlong->FindLocationClosestToWorldLocation(ChaseActorSettings.ActorToChase.Get()->GetActorLocation(), ESplineCoordinateSpace::World);
+			const FVector ChasedActorLocation = ChaseActorSettings.ActorToChase.Get()->GetActorLocation();
+			FVector NewClosestPointOnChaseSpline{};
+			if (ChaseLookupTable)
+			{
+				const FTransform &SplineTransform = SplineToChaseAlong->GetComponentTransform();
+				NewClosestPointOnChaseSpline = ChaseLookupTable->GetLocationAtDistance(ChaseLookupTable->FindDistanceClosestToLocation(ChasedActorLocation, SplineTransform), SplineTransform);
+			}
+			else
+			{
+				NewClosestPointOnChaseSpline = SplineToChaseAlong->FindLocationClosestToWorldLocation(ChasedActorLocation, ESplineCoordinateSpace::World);
+			}
 			OwnerActor->SetActorLocation(FMath::VInterpTo(CurrentClosestPointOnChaseSpline, NewClosestPointOnChaseSpline, DeltaTime, ChaseActorSettings.ChaseSpeed));
 		}
 		break;
 	case EPLChaseActorAlongSplineChaseMode::FollowPositionOnReferenceSpline:
 		if (IsValid(OwnerActor) && ChaseActorSettings.ActorToChase.IsValid(false, false) && SplineToChaseAlong.IsValid(false, false) && ReferenceSplineToFollow.IsValid(false, false))
 		{
-			const float NormalizedReferenceSplineInputKey = ReferenceSplineToFollow->FindInputKeyClosestToWorldLocation(ChaseActorSettings.ActorToChase.Get()->GetActorLocation()) / ReferenceSplineToFollow->GetNumberOfSplineSegments();
-			const float CurrentInputKeyOnChaseSpline = SplineToChaseAlong->FindInputKeyClosestToWorldLocation(OwnerActor->GetActorLocation());
-			const float InputKeyOfReferenceSplineOnChaseSpline = NormalizedReferenceSplineInputKey * SplineToChaseAlong->GetNumberOfSplineSegments();
-			const float NewInputKeyOnChaseSpline = FMath::FInterpTo(CurrentInputKeyOnChaseSpline, InputKeyOfReferenceSplineOnChaseSpline, DeltaTime, ChaseActorSettings.ChaseSpeed);
-			OwnerActor->SetActorLocation(SplineToChaseAlong->GetLocationAtSplineInputKey(NewInputKeyOnChaseSpline, ESplineCoordinateSpace::World));
+			// the position is mapped segment by segment and by the arc length inside a segment, so that the chase moves uniformly also along curved segments
+			const float ReferenceDistance = FindReferenceSplineDistance(ChaseActorSettings.ActorToChase.Get()->GetActorLocation());
+			const float TargetChaseDistance = MapReferenceToChaseDistance(ReferenceDistance);
+
+			// the distance on the chase spline is kept from the previous frame, so that the owner does not have to be searched on the chase spline
+			if (!bFollowDistancesValid)
+			{
+				ChaseSplineDistance = ChaseLookupTable ? ChaseLookupTable->FindDistanceClosestToLocation(OwnerActor->GetActorLocation(), SplineToChaseAlong->GetComponentTransform())
+													   : SplineToChaseAlong->GetDistanceAlongSplineAtSplineInputKey(SplineToChaseAlong->FindInputKeyClosestToWorldLocation(OwnerActor->GetActorLocation()));
+				bFollowDistancesValid = true;
+			}
+			ChaseSplineDistance = FMath::FInterpTo(ChaseSplineDistance, TargetChaseDistance, DeltaTime, ChaseActorSettings.ChaseSpeed);
+			OwnerActor->SetActorLocation(ChaseLookupTable ? ChaseLookupTable->GetLocationAtDistance(ChaseSplineDistance, SplineToChaseAlong->GetComponentTransform())
+														  : SplineToChaseAlong->GetLocationAtDistanceAlongSpline(ChaseSplineDistance, ESplineCoordinateSpace::World));
 		}
 		break;
 	default:
@@ -68,46 +102,189 @@ const AActor *UPLChaseActorAlongSplineComponent::GetChasedActor() const
 
 void UPLChaseActorAlongSplineComponent::SetChaseActor(AActor *ActorToChase)
 {
+	// a new chased actor can be anywhere on the reference spline
+	if (ChaseActorSettings.ActorToChase.Get() != ActorToChase)
+	{
+		bFollowDistancesValid = false;
+	}
 	ChaseActorSettings.ActorToChase = ActorToChase;
 }
 
-void UPLChaseActorAlongSplineComponent::BeginPlay()
+#if WITH_EDITOR
+void UPLChaseActorAlongSplineComponent::PreSave(FObjectPreSaveContext ObjectSaveContext)
 {
-	Super::BeginPlay();
+	Super::PreSave(ObjectSaveContext);
 
-	// Get the SplineComponent of the Actor the Owner is attached to.
-	const AActor *OwnerActor = GetOwner();
-	if (IsValid(OwnerActor))
+	if (const USplineComponent *ChaseSpline = FindChaseSpline(); ChaseSpline)
 	{
-		AActor *AttachParentActor = OwnerActor->GetAttachParentActor();
-		if (IsValid(AttachParentActor))
-		{
-			USplineComponent *SplineComponent = AttachParentActor->GetComponentByClass<USplineComponent>();
-			if (IsValid(SplineComponent))
-			{
-				SplineToChaseAlong = SplineComponent;
-			}
-		}
+		ChaseSplineBakedLookupTable.Bake(*ChaseSpline);
+	}
+	else
+	{
+		ChaseSplineBakedLookupTable.Reset();
 	}
 
+	const USplineComponent *ReferenceSpline = (ChaseActorSettings.ChaseMode == EPLChaseActorAlongSplineChaseMode::FollowPositionOnReferenceSpline) ? FindReferenceSpline() : nullptr;
+	if (ReferenceSpline)
+	{
+		ReferenceSplineBakedLookupTable.Bake(*ReferenceSpline);
+	}
+	else
+	{
+		ReferenceSplineBakedLookupTable.Reset();
+	}
+}
+#endif
+
+void UPLChaseActorAlongSplineComponent::RefreshSplines()
+{
+	// the tables of the previous splines are released first
+	UnregisterLookupTables();
+
+	SplineToChaseAlong = FindChaseSpline();
+
 	// Get the reference SplineComponent for the FollowPositionOnReferenceSpline state.
-	if (ChaseActorSettings.ChaseMode == EPLChaseActorAlongSplineChaseMode::FollowPositionOnReferenceSpline)
+	ReferenceSplineToFollow = (ChaseActorSettings.ChaseMode == EPLChaseActorAlongSplineChaseMode::FollowPositionOnReferenceSpline) ? FindReferenceSpline() : nullptr;
+	bFollowDistancesValid = false;
+
+	// the mapping between the splines only depends on their shapes, so it is built once per spline pair
+	ReferenceSegmentDistances.Reset();
+	ChaseSegmentDistances.Reset();
+	if (SplineToChaseAlong.IsValid() && ReferenceSplineToFollow.IsValid())
+	{
+		BuildSegmentDistances(*ReferenceSplineToFollow, ReferenceSegmentDistances);
+		BuildSegmentDistances(*SplineToChaseAlong, ChaseSegmentDistances);
+	}
+
+	// The baked tables are shared with other users of the splines. A table baked by another user is used, if this one is outdated.
+	if (UPLSplineLookupSubsystem *SplineLookupSubsystem = GetWorld()->GetSubsystem<UPLSplineLookupSubsystem>(); SplineLookupSubsystem)
 	{
-		if (ChaseActorSettings.ReferenceSplineActor.IsValid(false, false))
+		if (SplineToChaseAlong.IsValid())
 		{
-			USplineComponent *SplineComponent = ChaseActorSettings.ReferenceSplineActor.Get()->GetComponentByClass<USplineComponent>();
-			if (IsValid(SplineComponent))
-			{
-				ReferenceSplineToFollow = SplineComponent;
-			}
+			SplineLookupSubsystem->RegisterLookupTable(SplineToChaseAlong.Get(), ChaseSplineBakedLookupTable);
+			ChaseSplineLookupTable = SplineLookupSubsystem->FindLookupTable(SplineToChaseAlong.Get());
+		}
+		if (ReferenceSplineToFollow.IsValid())
+		{
+			SplineLookupSubsystem->RegisterLookupTable(ReferenceSplineToFollow.Get(), ReferenceSplineBakedLookupTable);
+			ReferenceSplineLookupTable = SplineLookupSubsystem->FindLookupTable(ReferenceSplineToFollow.Get());
 		}
 	}
 }
 
+void UPLChaseActorAlongSplineComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	RefreshSplines();
+}
+
+void UPLChaseActorAlongSplineComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	UnregisterLookupTables();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UPLChaseActorAlongSplineComponent::UnregisterLookupTables()
+{
+	if (UPLSplineLookupSubsystem *SplineLookupSubsystem = GetWorld()->GetSubsystem<UPLSplineLookupSubsystem>(); SplineLookupSubsystem)
+	{
+		SplineLookupSubsystem->UnregisterLookupTable(SplineToChaseAlong.Get(), ChaseSplineBakedLookupTable);
+		SplineLookupSubsystem->UnregisterLookupTable(ReferenceSplineToFollow.Get(), ReferenceSplineBakedLookupTable);
+	}
+	ChaseSplineLookupTable = nullptr;
+	ReferenceSplineLookupTable = nullptr;
+}
+
+const FPLSplineLookupTable *UPLChaseActorAlongSplineComponent::GetChaseSplineLookupTable() const
+{
+	return UPLSplineLookupSubsystem::AreLookupTablesEnabled() ? ChaseSplineLookupTable : nullptr;
+}
+
+const FPLSplineLookupTable *UPLChaseActorAlongSplineComponent::GetReferenceSplineLookupTable() const
+{
+	return UPLSplineLookupSubsystem::AreLookupTablesEnabled() ? ReferenceSplineLookupTable : nullptr;
+}
+
+float UPLChaseActorAlongSplineComponent::FindReferenceSplineDistance(const FVector &ChasedActorLocation)
+{
+	const FPLSplineLookupTable *LookupTable = GetReferenceSplineLookupTable();
+	if (!LookupTable)
+	{
+		return ReferenceSplineToFollow->GetDistanceAlongSplineAtSplineInputKey(ReferenceSplineToFollow->FindInputKeyClosestToWorldLocation(ChasedActorLocation));
+	}
+
+	const FTransform &ReferenceSplineTransform = ReferenceSplineToFollow->GetComponentTransform();
+	if (bFollowDistancesValid)
+	{
+		// the chased actor moved only a bit since the previous frame, so only the part of the spline around the previous distance is searched
+		const float SearchDistance = ReferenceSplineSearchDistance + static_cast<float>(FVector::Dist(ChasedActorLocation, PreviousChasedActorLocation));
+		ReferenceSplineDistance = LookupTable->FindDistanceClosestToLocation(ChasedActorLocation, ReferenceSplineTransform, ReferenceSplineDistance, SearchDistance);
+	}
+	else
+	{
+		ReferenceSplineDistance = LookupTable->FindDistanceClosestToLocation(ChasedActorLocation, ReferenceSplineTransform);
+	}
+	PreviousChasedActorLocation = ChasedActorLocation;
+
+	return ReferenceSplineDistance;
+}
+
+void UPLChaseActorAlongSplineComponent::BuildSegmentDistances(const USplineComponent &Spline, TArray<float> &OutSegmentDistances)
+{
+	const int32 NumSegments{Spline.GetNumberOfSplineSegments()};
+	OutSegmentDistances.Reserve(OutSegmentDistances.Num() + NumSegments + 1);
+	for (int32 SegmentIndex = 0; SegmentIndex < NumSegments; ++SegmentIndex)
+	{
+		OutSegmentDistances.Add(Spline.GetDistanceAlongSplineAtSplinePoint(SegmentIndex));
+	}
+	OutSegmentDistances.Add(Spline.GetSplineLength());
+}
+
+float UPLChaseActorAlongSplineComponent::MapReferenceToChaseDistance(float ReferenceDistance) const
+{
+	const int32 NumReferenceSegments{ReferenceSegmentDistances.Num() - 1};
+	const int32 NumChaseSegments{ChaseSegmentDistances.Num() - 1};
+	if ((NumReferenceSegments < 1) || (NumChaseSegments < 1))
+	{
+		return 0.0f;
+	}
+
+	// find the segment of the reference distance and the arc-length fraction inside of it
+	ReferenceDistance = FMath::Clamp(ReferenceDistance, ReferenceSegmentDistances[0], ReferenceSegmentDistances.Last());
+	const int32 ReferenceSegment{FMath::Clamp(Algo::UpperBound(ReferenceSegmentDistances, ReferenceDistance) - 1, 0, NumReferenceSegments - 1)};
+	const float ReferenceSegmentLength{ReferenceSegmentDistances[ReferenceSegment + 1] - ReferenceSegmentDistances[ReferenceSegment]};
+	const float ReferenceAlpha{(ReferenceSegmentLength > UE_KINDA_SMALL_NUMBER) ? ((ReferenceDistance - ReferenceSegmentDistances[ReferenceSegment]) / ReferenceSegmentLength) : 0.0f};
+
+	// the normalized segment position corresponds on both splines
+	const float ChaseSegmentPosition{(ReferenceSegment + ReferenceAlpha) / NumReferenceSegments * NumChaseSegments};
+	const int32 ChaseSegment{FMath::Clamp(FMath::FloorToInt32(ChaseSegmentPosition), 0, NumChaseSegments - 1)};
+	const float ChaseAlpha{FMath::Clamp(ChaseSegmentPosition - ChaseSegment, 0.0f, 1.0f)};
+
+	return FMath::Lerp(ChaseSegmentDistances[ChaseSegment], ChaseSegmentDistances[ChaseSegment + 1], ChaseAlpha);
+}
+
+USplineComponent *UPLChaseActorAlongSplineComponent::FindChaseSpline() const
+{
+	// Get the SplineComponent of the Actor the Owner is attached to.
+	const AActor *OwnerActor = GetOwner();
+	AActor *AttachParentActor = IsValid(OwnerActor) ? OwnerActor->GetAttachParentActor() : nullptr;
+	USplineComponent *SplineComponent = IsValid(AttachParentActor) ? AttachParentActor->GetComponentByClass<USplineComponent>() : nullptr;
+	return IsValid(SplineComponent) ? SplineComponent : nullptr;
+}
+
+USplineComponent *UPLChaseActorAlongSplineComponent::FindReferenceSpline() const
+{
+	USplineComponent *SplineComponent = ChaseActorSettings.ReferenceSplineActor.IsValid(false, false) ? ChaseActorSettings.ReferenceSplineActor.Get()->GetComponentByClass<USplineComponent>() : nullptr;
+	return IsValid(SplineComponent) ? SplineComponent : nullptr;
+}
+
 void UPLChaseActorAlongSplineComponent::ActorModeChanged()
 {
 	// Invalidate chased actor, since when we change from "Player to Actor" the ActorToChase will not be automatically set.
 	ChaseActorSettings.ActorToChase = nullptr;
+	bFollowDistancesValid = false;
 }
 
 void UPLChaseActorAlongSplineComponent::SetChaseActorForPlayerActorMode()
@@ -119,3 +296,14 @@ void UPLChaseActorAlongSplineComponent::SetChaseActorForPlayerActorMode()
 		SetChaseActor(Cast<AActor>(Player));
 	}
 }
+
+void UPLChaseActorAlongSplineComponent::SetChaseActorForNearestPlayerActorMode()
+{
+	if (UPLLocalPlayersSubsystem *LocalPlayersSubsystem = GetWorld()->GetSubsystem<UPLLocalPlayersSubsystem>(); LocalPlayersSubsystem)
+	{
+		if (APawn *Player = LocalPlayersSubsystem->GetNearestPlayerPawn(GetOwner()); Player)
+		{
+			SetChaseActor(Player);
+		}
+	}
+}
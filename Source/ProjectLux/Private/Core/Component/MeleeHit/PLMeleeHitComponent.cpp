@@ -0,0 +1,193 @@
+// Copyright TinyAlmonds (Alex Noerdemann)
+#include "Core/Component/MeleeHit/PLMeleeHitComponent.h"
+
+#include "AbilitySystemComponent.h"
+#include "AbilitySystemGlobals.h"
+#include "Components/CapsuleComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/OverlapResult.h"
+#include "Engine/World.h"
+#include "GameFramework/Character.h"
+#include "GameplayEffect.h"
+
+#include "Core/AbilitySystem/PLGameplayTags.h"
+#include "Core/PLEnemyCharacterBase.h"
+#include "Core/Subsystem/PLHitchDetectorSubsystem.h"
+
+UPLMeleeHitComponent::UPLMeleeHitComponent() : TargetClass{APLEnemyCharacterBase::StaticClass()}
+{
+	// the sockets are swept after the animation of the frame was evaluated
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+	PrimaryComponentTick.TickGroup = TG_PostPhysics;
+}
+
+void UPLMeleeHitComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction *ThisTickFunction)
+{
+	PL_SCOPE_HITCH_STAGE(MeleeHit);
+
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	if (!bSwinging)
+	{
+		return;
+	}
+
+	TArray<AActor *, TInlineAllocator<NumInlineElements>> HitActors{};
+	TArray<FVector, TInlineAllocator<NumInlineElements>> HitLocations{};
+	SweepWeapon(HitActors, HitLocations);
+
+	if (HitActors.IsEmpty())
+	{
+		return;
+	}
+
+	ApplyDamage(HitActors);
+
+	for (int32 HitIndex = 0; HitIndex < HitActors.Num(); ++HitIndex)
+	{
+		OnMeleeHit.Broadcast(HitActors[HitIndex], HitLocations[HitIndex]);
+	}
+}
+
+void UPLMeleeHitComponent::BeginSwing(float Level)
+{
+	bSwinging = true;
+	HitActorsOfSwing.Reset();
+	GatherBroadphaseTargets();
+	GetSocketLocations(PreviousSocketLocations);
+
+	DamageEffectSpecHandle = FGameplayEffectSpecHandle{};
+	if (UAbilitySystemComponent *AbilitySystemComponent = UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(GetOwner()); AbilitySystemComponent && DamageEffect)
+	{
+		FGameplayEffectContextHandle EffectContext = AbilitySystemComponent->MakeEffectContext();
+		EffectContext.AddSourceObject(GetOwner());
+		DamageEffectSpecHandle = AbilitySystemComponent->MakeOutgoingSpec(DamageEffect, Level, EffectContext);
+
+		// the UPLAttackDamageExecution skips the immunity effect only for the hits of the swing, since the swing already hits every target at most once
+		if (FGameplayEffectSpec *DamageEffectSpec = DamageEffectSpecHandle.Data.Get(); DamageEffectSpec)
+		{
+			DamageEffectSpec->AddDynamicAssetTag(PLGameplayTags::GameplayEffect_Damage_MeleeSwing);
+		}
+	}
+
+	SetComponentTickEnabled(true);
+}
+
+void UPLMeleeHitComponent::EndSwing()
+{
+	bSwinging = false;
+	BroadphaseTargets.Reset();
+	HitActorsOfSwing.Reset();
+	DamageEffectSpecHandle = FGameplayEffectSpecHandle{};
+
+	SetComponentTickEnabled(false);
+}
+
+bool UPLMeleeHitComponent::IsSwinging() const
+{
+	return bSwinging;
+}
+
+void UPLMeleeHitComponent::GatherBroadphaseTargets()
+{
+	BroadphaseTargets.Reset();
+
+	AActor *OwnerActor = GetOwner();
+	UWorld *World = GetWorld();
+	if (!OwnerActor || !World)
+	{
+		return;
+	}
+
+	FCollisionQueryParams QueryParams{SCENE_QUERY_STAT(PLMeleeHitBroadphase), false, OwnerActor};
+	TArray<FOverlapResult> Overlaps{};
+	World->OverlapMultiByObjectType(Overlaps, OwnerActor->GetActorLocation(), FQuat::Identity, FCollisionObjectQueryParams{ECC_Pawn}, FCollisionShape::MakeSphere(BroadphaseRadius), QueryParams);
+
+	for (const FOverlapResult &Overlap : Overlaps)
+	{
+		if (const ACharacter *Character = Cast<ACharacter>(Overlap.GetActor()); Character && (!TargetClass || Character->IsA(TargetClass)))
+		{
+			BroadphaseTargets.AddUnique(Character->GetCapsuleComponent());
+		}
+	}
+}
+
+void UPLMeleeHitComponent::SweepWeapon(TArray<AActor *, TInlineAllocator<NumInlineElements>> &OutHitActors, TArray<FVector, TInlineAllocator<NumInlineElements>> &OutHitLocations)
+{
+	TArray<FVector, TInlineAllocator<NumInlineElements>> SocketLocations{};
+	if (!GetSocketLocations(SocketLocations) || (SocketLocations.Num() != PreviousSocketLocations.Num()))
+	{
+		PreviousSocketLocations = SocketLocations;
+		return;
+	}
+
+	for (const TWeakObjectPtr<UCapsuleComponent> &BroadphaseTarget : BroadphaseTargets)
+	{
+		const UCapsuleComponent *Capsule = BroadphaseTarget.Get();
+		AActor *TargetActor = Capsule ? Capsule->GetOwner() : nullptr;
+		if (!TargetActor || HitActorsOfSwing.Contains(TargetActor))
+		{
+			continue;
+		}
+
+		// the capsule is the segment between the centers of its hemispheres, inflated by its radius
+		const float CapsuleRadius{Capsule->GetScaledCapsuleRadius()};
+		const FVector CapsuleAxis{Capsule->GetUpVector() * (Capsule->GetScaledCapsuleHalfHeight() - CapsuleRadius)};
+		const FVector CapsuleCenter{Capsule->GetComponentLocation()};
+		const float HitDistance{CapsuleRadius + WeaponRadius};
+
+		for (int32 SocketIndex = 0; SocketIndex < SocketLocations.Num(); ++SocketIndex)
+		{
+			FVector WeaponPoint{};
+			FVector CapsulePoint{};
+			FMath::SegmentDistToSegmentSafe(PreviousSocketLocations[SocketIndex], SocketLocations[SocketIndex], CapsuleCenter - CapsuleAxis, CapsuleCenter + CapsuleAxis, WeaponPoint, CapsulePoint);
+
+			if (FVector::DistSquared(WeaponPoint, CapsulePoint) <= FMath::Square(HitDistance))
+			{
+				HitActorsOfSwing.Add(TargetActor);
+				OutHitActors.Add(TargetActor);
+				OutHitLocations.Add(CapsulePoint + (WeaponPoint - CapsulePoint).GetSafeNormal() * CapsuleRadius);
+				break;
+			}
+		}
+	}
+
+	PreviousSocketLocations = SocketLocations;
+}
+
+void UPLMeleeHitComponent::ApplyDamage(const TArray<AActor *, TInlineAllocator<NumInlineElements>> &HitActors) const
+{
+	UAbilitySystemComponent *AbilitySystemComponent = UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(GetOwner());
+	if (!AbilitySystemComponent || !DamageEffectSpecHandle.IsValid())
+	{
+		return;
+	}
+
+	for (AActor *HitActor : HitActors)
+	{
+		if (UAbilitySystemComponent *TargetAbilitySystemComponent = UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(HitActor); TargetAbilitySystemComponent)
+		{
+			AbilitySystemComponent->ApplyGameplayEffectSpecToTarget(*DamageEffectSpecHandle.Data.Get(), TargetAbilitySystemComponent);
+		}
+	}
+}
+
+bool UPLMeleeHitComponent::GetSocketLocations(TArray<FVector, TInlineAllocator<NumInlineElements>> &OutSocketLocations) const
+{
+	OutSocketLocations.Reset();
+
+	const ACharacter *OwnerCharacter = Cast<ACharacter>(GetOwner());
+	const USkeletalMeshComponent *Mesh = OwnerCharacter ? OwnerCharacter->GetMesh() : nullptr;
+	if (!Mesh)
+	{
+		return false;
+	}
+
+	for (const FName &WeaponSocket : WeaponSockets)
+	{
+		OutSocketLocations.Add(Mesh->GetSocketLocation(WeaponSocket));
+	}
+
+	return true;
+}
@@ -1,8 +1,20 @@
 // Copyright TinyAlmonds (Alex Noerdemann)
 #include "Core/Component/TrackActor/PLTrackActorComponent.h"
 
+#include "Components/MeshComponent.h"
+#include "Components/SceneComponent.h"
 #include "Kismet/GameplayStatics.h"
 
+#include "Core/Subsystem/PLHitchDetectorSubsystem.h"
+#include "Core/Subsystem/PLLocalPlayersSubsystem.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogPLTrackActor, Log, All);
+
+namespace
+{
+	TAutoConsoleVariable<bool> CVarPLTrackDeadZone{TEXT("projectlux.FastPath.TrackDeadZone"), true, TEXT("Whether rotation changes of the tracking smaller than the RotationDeadZone are skipped. Every change is applied, if disabled."), ECVF_Cheat};
+}
+
 UPLTrackActorComponent::UPLTrackActorComponent()
 {
 	PrimaryComponentTick.bCanEverTick = true;
@@ -10,6 +22,8 @@ UPLTrackActorComponent::UPLTrackActorComponent()
 
 void UPLTrackActorComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction *ThisTickFunction)
 {
+	PL_SCOPE_HITCH_STAGE(TrackUpdate);
+
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
 	// We have to query the player on every tick, since the player can die and therefore the actor changes.
@@ -17,14 +31,24 @@ void UPLTrackActorComponent::TickComponent(float DeltaTime, ELevelTick TickType,
 	{
 		SetTrackActorForPlayerTrackMode();
 	}
+	else if (TrackActorSettings.Mode == EPLTrackActorMode::NearestPlayer)
+	{
+		SetTrackActorForNearestPlayerTrackMode();
+	}
 
-	AActor *OwnerActor = GetOwner();
+	const AActor *OwnerActor = GetOwner();
 	if (TrackActorSettings.Actor.IsValid(false, false) && IsValid(OwnerActor))
 	{
-		const FVector LookAt = TrackActorSettings.Actor.Get()->GetActorLocation() - OwnerActor->GetActorLocation();
-		const FRotator LookAtRotation = FMath::RInterpTo(OwnerActor->GetActorRotation(), LookAt.Rotation(), DeltaTime, TrackActorSettings.RotationRate);
+		const FVector LookAt = TrackActorSettings.Actor.Get()->GetActorLocation() - GetTrackLocation();
+		const FRotator TargetRotation = LookAt.Rotation();
+		// read back the actual rotation, since other systems (e.g. movement or Blueprints) may rotate the owner or component between our ticks
+		const FRotator CurrentRotation = GetTrackRotation();
 
-		OwnerActor->SetActorRotation(LookAtRotation);
+		// skip only if the remaining error is negligible, so that a settled tracking does not dirty any transform or parameter, while slow interpolation steps still reach the target
+		if (!CVarPLTrackDeadZone.GetValueOnGameThread() || !TargetRotation.Equals(CurrentRotation, TrackActorSettings.RotationDeadZone))
+		{
+			ApplyTrackRotation(FMath::RInterpTo(CurrentRotation, TargetRotation, DeltaTime, TrackActorSettings.RotationRate));
+		}
 	}
 }
 
@@ -54,9 +78,116 @@ void UPLTrackActorComponent::SetTrackActor(AActor *ActorToTrack)
 	TrackActorSettings.Actor = ActorToTrack;
 }
 
+FRotator UPLTrackActorComponent::GetTrackRotation() const
+{
+	switch (TrackActorSettings.RotationTarget)
+	{
+	case EPLTrackActorRotationTarget::Actor:
+		if (const AActor *OwnerActor = GetOwner(); IsValid(OwnerActor))
+		{
+			return OwnerActor->GetActorRotation();
+		}
+		break;
+	case EPLTrackActorRotationTarget::SceneComponent:
+		if (const USceneComponent *SceneComponent = RotatedComponent.Get(); SceneComponent)
+		{
+			return SceneComponent->GetComponentRotation();
+		}
+		break;
+	default:
+		break;
+	}
+
+	// the material parameters cannot be read back, hence the last applied rotation is used
+	return TrackRotation;
+}
+
 void UPLTrackActorComponent::BeginPlay()
 {
 	Super::BeginPlay();
+
+	const AActor *OwnerActor = GetOwner();
+	if (!IsValid(OwnerActor))
+	{
+		return;
+	}
+
+	TrackRotation = OwnerActor->GetActorRotation();
+	switch (TrackActorSettings.RotationTarget)
+	{
+	case EPLTrackActorRotationTarget::SceneComponent:
+		for (USceneComponent *SceneComponent : TInlineComponentArray<USceneComponent *>{OwnerActor})
+		{
+			if (SceneComponent->GetFName() == TrackActorSettings.RotatedComponentName)
+			{
+				RotatedComponent = SceneComponent;
+				TrackRotation = SceneComponent->GetComponentRotation();
+				break;
+			}
+		}
+		if (!RotatedComponent.IsValid())
+		{
+			UE_LOG(LogPLTrackActor, Warning, TEXT("%s: No scene component named %s found. The tracking does not rotate anything."), *GetReadableName(), *TrackActorSettings.RotatedComponentName.ToString());
+		}
+		break;
+	case EPLTrackActorRotationTarget::Parameter:
+		for (UMeshComponent *MeshComponent : TInlineComponentArray<UMeshComponent *>{OwnerActor})
+		{
+			ParameterMeshComponents.Add(MeshComponent);
+		}
+		break;
+	default:
+		break;
+	}
+}
+
+FVector UPLTrackActorComponent::GetTrackLocation() const
+{
+	if (TrackActorSettings.RotationTarget == EPLTrackActorRotationTarget::SceneComponent)
+	{
+		if (const USceneComponent *SceneComponent = RotatedComponent.Get(); SceneComponent)
+		{
+			return SceneComponent->GetComponentLocation();
+		}
+	}
+
+	return GetOwner()->GetActorLocation();
+}
+
+void UPLTrackActorComponent::ApplyTrackRotation(const FRotator &Rotation)
+{
+	TrackRotation = Rotation;
+
+	switch (TrackActorSettings.RotationTarget)
+	{
+	case EPLTrackActorRotationTarget::Actor:
+		GetOwner()->SetActorRotation(Rotation);
+		break;
+	case EPLTrackActorRotationTarget::SceneComponent:
+		if (USceneComponent *SceneComponent = RotatedComponent.Get(); SceneComponent)
+		{
+			SceneComponent->SetWorldRotation(Rotation);
+		}
+		break;
+	case EPLTrackActorRotationTarget::Parameter:
+		for (const TWeakObjectPtr<UMeshComponent> &ParameterMeshComponent : ParameterMeshComponents)
+		{
+			if (UMeshComponent *MeshComponent = ParameterMeshComponent.Get(); MeshComponent)
+			{
+				if (!TrackActorSettings.YawParameterName.IsNone())
+				{
+					MeshComponent->SetScalarParameterValueOnMaterials(TrackActorSettings.YawParameterName, static_cast<float>(Rotation.Yaw));
+				}
+				if (!TrackActorSettings.PitchParameterName.IsNone())
+				{
+					MeshComponent->SetScalarParameterValueOnMaterials(TrackActorSettings.PitchParameterName, static_cast<float>(Rotation.Pitch));
+				}
+			}
+		}
+		break;
+	default:
+		break;
+	}
 }
 
 void UPLTrackActorComponent::TrackModeChanged()
@@ -74,3 +205,14 @@ void UPLTrackActorComponent::SetTrackActorForPlayerTrackMode()
 		SetTrackActor(Cast<AActor>(Player));
 	}
 }
+
+void UPLTrackActorComponent::SetTrackActorForNearestPlayerTrackMode()
+{
+	if (UPLLocalPlayersSubsystem *LocalPlayersSubsystem = GetWorld()->GetSubsystem<UPLLocalPlayersSubsystem>(); LocalPlayersSubsystem)
+	{
+		if (APawn *Player = LocalPlayersSubsystem->GetNearestPlayerPawn(GetOwner()); Player)
+		{
+			SetTrackActor(Player);
+		}
+	}
+}
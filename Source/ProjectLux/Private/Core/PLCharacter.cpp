@@ -4,6 +4,7 @@
 
 #include "Abilities/GameplayAbility.h"
 #include "AbilitySystemComponent.h"
+#include "Camera/CameraActor.h"
 #include "Camera/CameraComponent.h"
 #include "Components/CapsuleComponent.h"
 #include "Components/SplineComponent.h"
@@ -14,66 +15,89 @@
 #include "Misc/Optional.h"
 
 #include "Core/PLPlayerController.h"
+#include "Core/AbilitySystem/PLAbilitySet.h"
+#include "Core/AbilitySystem/PLAbilitySystemComponent.h"
+#include "Core/AbilitySystem/PLGameplayTags.h"
 #include "Core/AbilitySystem/PLCharacterAttributeSet.h"
 #include "Core/AbilitySystem/PLMovementAttributeSet.h"
+#include "Core/Benchmark/PLMemoryTags.h"
+#include "Core/Component/CharacterMovement/PLCharacterMovementComponent.h"
+#include "Core/Component/MeleeHit/PLMeleeHitComponent.h"
+#include "Core/Subsystem/PLHitchDetectorSubsystem.h"
+#include "Core/Subsystem/PLWallProximitySubsystem.h"
+
+APLCharacter::APLCharacter(const FObjectInitializer &ObjectInitializer) : Super(ObjectInitializer.SetDefaultSubobjectClass<UPLCharacterMovementComponent>(ACharacter::CharacterMovementComponentName)),
+																		  AxisValueMoveUp{0.0f},
+																		  AxisValueMoveRight{0.0f},
+																		  bWallSlidingFlag{false},
+																		  MovementSpace{EPLMovementSpaceState::MovementIn3D},
+																		  PreviousMovementSpace{EPLMovementSpaceState::MovementIn3D},
+																		  MovementSplineComponentFromWorld{nullptr}
+{
+	LLM_SCOPE_BYTAG(ProjectLux_Character);
 
-APLCharacter::APLCharacter() : AxisValueMoveUp{0.0f},
-							   AxisValueMoveRight{0.0f},
-							   bWallSlidingFlag{false},
-							   MovementSpace{EPLMovementSpaceState::MovementIn3D},
-							   PreviousMovementSpace{EPLMovementSpaceState::MovementIn3D},
-							   MovementSplineComponentFromWorld{nullptr},
-							   SprintAbilityTag{FGameplayTag::RequestGameplayTag(FName("Ability.Movement.Sprint"))},
-							   WallSlideAbilityTag{FGameplayTag::RequestGameplayTag(FName("Ability.Movement.WallSlide"))},
-							   WallJumpAbilityTag{FGameplayTag::RequestGameplayTag(FName("Ability.Movement.WallJump"))},
-							   DashAbilityTag{FGameplayTag::RequestGameplayTag(FName("Ability.Movement.Dash"))},
-							   DoubleDashAbilityTag{FGameplayTag::RequestGameplayTag(FName("Ability.Movement.DoubleDash"))},
-							   QuickStepAbilityTag{FGameplayTag::RequestGameplayTag(FName("Ability.Movement.QuickStep"))},
-							   GlideAbilityTag{FGameplayTag::RequestGameplayTag(FName("Ability.Movement.Glide"))},
-							   AttackAbilityTag{FGameplayTag::RequestGameplayTag(FName("Ability.Combat.Attack"))},
-							   DeadTag{FGameplayTag::RequestGameplayTag(FName("Status.Dead"))}
-{
 	// Set this character to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
 	PrimaryActorTick.bCanEverTick = true;
 
 	// Construct the ASC
-	AbilitySystemComponent = CreateDefaultSubobject<UAbilitySystemComponent>(TEXT("AbilitySystemComponent"));
+	AbilitySystemComponent = CreateDefaultSubobject<UPLAbilitySystemComponent>(TEXT("AbilitySystemComponent"));
 
 	// Construct the attribute sets
 	AttributeSet = CreateDefaultSubobject<UPLCharacterAttributeSet>(TEXT("AttributeSet"));
 	MovementAttributeSet = CreateDefaultSubobject<UPLMovementAttributeSet>(TEXT("MovementAttributeSet"));
 
+	// Construct the hit detection of the attack ability
+	MeleeHitComponent = CreateDefaultSubobject<UPLMeleeHitComponent>(TEXT("MeleeHitComponent"));
+
 	// Fill the FGameplayTagContainer which blocking certain inputs/abilities
-	MoveBlockingAbilityTags.AddTag(FGameplayTag::RequestGameplayTag(FName("Reject.MoveInput")));
-	MoveBlockingAbilityTags.AddTag(DashAbilityTag);
-	MoveBlockingAbilityTags.AddTag(DoubleDashAbilityTag);
-	MoveBlockingAbilityTags.AddTag(QuickStepAbilityTag);
+	MoveBlockingAbilityTags.AddTag(PLGameplayTags::Reject_MoveInput);
+	MoveBlockingAbilityTags.AddTag(PLGameplayTags::Ability_Movement_Dash);
+	MoveBlockingAbilityTags.AddTag(PLGameplayTags::Ability_Movement_DoubleDash);
+	MoveBlockingAbilityTags.AddTag(PLGameplayTags::Ability_Movement_QuickStep);
+}
+
+void APLCharacter::PostLoad()
+{
+	Super::PostLoad();
+
+	// the properties are reset, so that instances copying them from their archetype do not migrate them again
+	if (UPLAbilitySet *MigratedAbilitySet = UPLAbilitySet::CreateFromDeprecatedProperties(*this, DefaultAbilities, DefaultPassiveAbilities, {AttributeSetInitEffect, MovementAttributeSetInitEffect}); MigratedAbilitySet)
+	{
+		AbilitySets.Add(MigratedAbilitySet);
+		DefaultAbilities.Reset();
+		DefaultPassiveAbilities.Reset();
+		AttributeSetInitEffect = nullptr;
+		MovementAttributeSetInitEffect = nullptr;
+	}
 }
 
 void APLCharacter::Tick(float DeltaTime)
 {
+	PL_SCOPE_HITCH_STAGE(CharacterTick);
+
 	Super::Tick(DeltaTime);
 
+	// apply a requested movement space transition, when it was not superseded by another request in the debounce time
+	if (bMovementSpaceTransitionPending && ((GetWorld()->GetTimeSeconds() - MovementSpaceTransitionRequestTime) >= MovementSpaceTransitionDebounceTime))
+	{
+		bMovementSpaceTransitionPending = false;
+		if (!IsMovementSpaceTransitionApplied(PendingMovementSpaceTransition))
+		{
+			ApplyMovementSpaceTransition(PendingMovementSpaceTransition);
+		}
+	}
+
 	UpdateWallSlidingFlag();
 
 	MoveDirection = GetMoveDirectionFromMoveInput(FVector2D{AxisValueMoveUp, AxisValueMoveRight});
 
-	// Snap Character to closest Spline location, when in Spline Movement:
-	if ((MovementSpace == EPLMovementSpaceState::MovementOnSpline) && MovementSplineComponentFromWorld)
-	{
-		FVector CharacterWorldLocation = GetRootComponent()->GetComponentLocation();
-		// We only want to find the closest location on the spline in the XY plane, since the Character can move freely in the Z direction.
-		FVector ClosestWorldLocationOnSpline = MovementSplineComponentFromWorld->FindLocationClosestToWorldLocation(FVector{CharacterWorldLocation.X, CharacterWorldLocation.Y, 0.0f}, ESplineCoordinateSpace::World);
-		GetRootComponent()->SetWorldLocation(FVector{ClosestWorldLocationOnSpline.X, ClosestWorldLocationOnSpline.Y, CharacterWorldLocation.Z});
-	}
-
 	// Handle other movement and rotation topics, depending on abilities:
 	UCharacterMovementComponent *CharacterMovementComponent = GetCharacterMovement();
 	if (AbilitySystemComponent)
 	{
 		if (AbilitySystemComponent->HasAnyMatchingGameplayTags(MoveBlockingAbilityTags) == false)
 		{
-			if (AbilitySystemComponent->HasAnyMatchingGameplayTags(FGameplayTagContainer(WallSlideAbilityTag)) == false)
+			if (AbilitySystemComponent->HasAnyMatchingGameplayTags(FGameplayTagContainer(PLGameplayTags::Ability_Movement_WallSlide)) == false)
 			{
 				AddMovementInput(MoveDirection);
 			}
@@ -93,10 +117,9 @@ void APLCharacter::Tick(float DeltaTime)
 			// Rotate Character while moving on a Spline.
 			if ((MovementSpace == EPLMovementSpaceState::MovementOnSpline) && MovementSplineComponentFromWorld)
 			{
-				FVector CharacterWorldLocation = GetRootComponent()->GetComponentLocation();
-				FRotator ClosestWorldRotationOnSpline = MovementSplineComponentFromWorld->FindRotationClosestToWorldLocation(FVector{CharacterWorldLocation.X, CharacterWorldLocation.Y, 0.0f}, ESplineCoordinateSpace::World);
+				FRotator ClosestWorldRotationOnSpline = GetMovementSplineDirection().Rotation();
 
-				// Face/rotate the Character in moving direction, since the FindRotationClosestToWorldLocation() does not account for this.
+				// Face/rotate the Character in moving direction, since the spline direction does not account for this.
 				if (FMath::Abs(ClosestWorldRotationOnSpline.Yaw - GetActorForwardVector().Rotation().Yaw) > 90.0f)
 				{
 					ClosestWorldRotationOnSpline.Yaw += 180.0f;
@@ -110,14 +133,6 @@ void APLCharacter::Tick(float DeltaTime)
 			}
 		}
 	}
-
-	// Limit negative Z-Velocity (for better falling/air control, etc.).
-	if (CharacterMovementComponent && MovementAttributeSet)
-	{
-		FVector CharacterVelocity = CharacterMovementComponent->Velocity;
-		CharacterVelocity.Z = (CharacterVelocity.Z < 0.0f) ? FMath::Max(CharacterVelocity.Z, MovementAttributeSet->GetMaxFallSpeed()) : CharacterVelocity.Z;
-		CharacterMovementComponent->Velocity = CharacterVelocity;
-	}
 }
 
 UAbilitySystemComponent *APLCharacter::GetAbilitySystemComponent() const
@@ -125,49 +140,42 @@ UAbilitySystemComponent *APLCharacter::GetAbilitySystemComponent() const
 	return AbilitySystemComponent;
 }
 
+UPLCharacterMovementComponent *APLCharacter::GetPLCharacterMovement() const
+{
+	return Cast<UPLCharacterMovementComponent>(GetCharacterMovement());
+}
+
 void APLCharacter::PossessedBy(AController *NewController)
 {
+	LLM_SCOPE_BYTAG(ProjectLux_Character);
 	Super::PossessedBy(NewController);
 
 	if (AbilitySystemComponent)
 	{
 		AbilitySystemComponent->InitAbilityActorInfo(this, this);
 
-		// remove and add again the default abilities in case of changes
+		// remove and give again the ability sets in case of changes (the sets are preloaded by the APLGameMode)
 		AbilitySystemComponent->ClearAllAbilities();
-		for (TSubclassOf<UGameplayAbility> const &DefaultAbility : DefaultAbilities)
-		{
-			AbilitySystemComponent->GiveAbility(FGameplayAbilitySpec(DefaultAbility, 1, -1, this));
-		}
-
-		// add again the default passive abilities in case of changes
-		for (TSubclassOf<UGameplayAbility> const &DefaultPassiveAbility : DefaultPassiveAbilities)
-		{
-			const FGameplayAbilitySpecHandle AppliedPassiveAbilitySpecHandle{AbilitySystemComponent->GiveAbility(FGameplayAbilitySpec(DefaultPassiveAbility, 1, -1, this))};
-			AbilitySystemComponent->TryActivateAbility(AppliedPassiveAbilitySpecHandle);
-		}
-
-		// initialize AttributeSet by an instant GameplayEffect (which does exactly this)
+		PassiveAbilitySpecHandles.Reset();
+		for (const UPLAbilitySet *AbilitySet : AbilitySets)
 		{
-			FGameplayEffectContextHandle EffectContext = AbilitySystemComponent->MakeEffectContext();
-			EffectContext.AddSourceObject(this);
-			AbilitySystemComponent->ApplyGameplayEffectToSelf(AttributeSetInitEffect.GetDefaultObject(), 1.0f, EffectContext);
+			if (AbilitySet)
+			{
+				AbilitySet->GiveToAbilitySystem(*AbilitySystemComponent, this, PassiveAbilitySpecHandles);
+			}
 		}
 
-		// initialize movement related AttributeSet by an instant GameplayEffect (which does exactly this)
-		{
-			FGameplayEffectContextHandle EffectContext = AbilitySystemComponent->MakeEffectContext();
-			EffectContext.AddSourceObject(this);
-			AbilitySystemComponent->ApplyGameplayEffectToSelf(MovementAttributeSetInitEffect.GetDefaultObject(), 1.0f, EffectContext);
-		}
+		// capture the initialized attributes, so that a respawn only has to restore them
+		SpawnAttributeSnapshot = FPLAttributeSnapshot::Capture(*AbilitySystemComponent);
 
-		// add delegates to attribute changes
-		AbilitySystemComponent->GetGameplayAttributeValueChangeDelegate(AttributeSet->GetHealthAttribute()).AddUObject(this, &APLCharacter::OnHealthChanged);
-		AbilitySystemComponent->GetGameplayAttributeValueChangeDelegate(MovementAttributeSet->GetMaxWalkSpeedAttribute()).AddUObject(this, &APLCharacter::OnMaxWalkSpeedAttributeChanged);
-		AbilitySystemComponent->GetGameplayAttributeValueChangeDelegate(MovementAttributeSet->GetJumpZVelocityAttribute()).AddUObject(this, &APLCharacter::OnJumpZVelocityAttributeChanged);
+		// add delegates to attribute changes (the bindings of a previous possession are removed first, so every delegate is bound exactly once)
+		AbilitySystemDelegateBindings.UnbindAll();
+		AbilitySystemDelegateBindings.BindAttributeValueChange(*AbilitySystemComponent, AttributeSet->GetHealthAttribute(), FOnGameplayAttributeValueChange::FDelegate::CreateUObject(this, &APLCharacter::OnHealthChanged));
+		AbilitySystemDelegateBindings.BindAttributeValueChange(*AbilitySystemComponent, MovementAttributeSet->GetMaxWalkSpeedAttribute(), FOnGameplayAttributeValueChange::FDelegate::CreateUObject(this, &APLCharacter::OnMaxWalkSpeedAttributeChanged));
+		AbilitySystemDelegateBindings.BindAttributeValueChange(*AbilitySystemComponent, MovementAttributeSet->GetJumpZVelocityAttribute(), FOnGameplayAttributeValueChange::FDelegate::CreateUObject(this, &APLCharacter::OnJumpZVelocityAttributeChanged));
 
 		// add delegates to GameplayTag changes
-		AbilitySystemComponent->RegisterGameplayTagEvent(DeadTag, EGameplayTagEventType::NewOrRemoved).AddUObject(this, &APLCharacter::DeadTagChanged);
+		AbilitySystemDelegateBindings.BindGameplayTagEvent(*AbilitySystemComponent, PLGameplayTags::Status_Dead, EGameplayTagEventType::NewOrRemoved, FOnGameplayEffectTagCountChanged::FDelegate::CreateUObject(this, &APLCharacter::DeadTagChanged));
 
 		// initialize values which use the Attributes from the related AttributeSet
 		UCharacterMovementComponent *CharacterMovementComponent = GetCharacterMovement();
@@ -179,11 +187,23 @@ void APLCharacter::PossessedBy(AController *NewController)
 	}
 }
 
+void APLCharacter::UnPossessed()
+{
+	AbilitySystemDelegateBindings.UnbindAll();
+
+	Super::UnPossessed();
+}
+
+const FPLAbilitySystemDelegateBindings &APLCharacter::GetAbilitySystemDelegateBindings() const
+{
+	return AbilitySystemDelegateBindings;
+}
+
 void APLCharacter::JumpPress()
 {
 	if (AbilitySystemComponent)
 	{
-		if (AbilitySystemComponent->TryActivateAbilitiesByTag(FGameplayTagContainer(WallJumpAbilityTag)) == false)
+		if (AbilitySystemComponent->TryActivateAbilitiesByTagCached(FGameplayTagContainer(PLGameplayTags::Ability_Movement_WallJump)) == false)
 		{
 			// block jumping when "movement blocking ability" are active
 			// Note: We are using the same tags as for the "move blocking", since they are the same.
@@ -218,16 +238,16 @@ void APLCharacter::SprintPress()
 		UCharacterMovementComponent *CharacterMovementComponent = GetCharacterMovement();
 		if (CharacterMovementComponent && !CharacterMovementComponent->IsFalling())
 		{
-			AbilitySystemComponent->TryActivateAbilitiesByTag(FGameplayTagContainer(SprintAbilityTag));
+			AbilitySystemComponent->TryActivateAbilitiesByTagCached(FGameplayTagContainer(PLGameplayTags::Ability_Movement_Sprint));
 		}
 	}
 }
 
 void APLCharacter::SprintRelease()
 {
-	if (AbilitySystemComponent->HasMatchingGameplayTag(SprintAbilityTag))
+	if (AbilitySystemComponent->HasMatchingGameplayTag(PLGameplayTags::Ability_Movement_Sprint))
 	{
-		FGameplayTagContainer SprintAbilityTags(SprintAbilityTag);
+		FGameplayTagContainer SprintAbilityTags(PLGameplayTags::Ability_Movement_Sprint);
 		AbilitySystemComponent->CancelAbilities(&SprintAbilityTags);
 	}
 }
@@ -237,21 +257,21 @@ void APLCharacter::DashPress()
 	if (AbilitySystemComponent)
 	{
 		// enable canceling of active Dash abilities to allow shorter dashes
-		if (AbilitySystemComponent->HasMatchingGameplayTag(DashAbilityTag))
+		if (AbilitySystemComponent->HasMatchingGameplayTag(PLGameplayTags::Ability_Movement_Dash))
 		{
-			FGameplayTagContainer DashAbilityTags(DashAbilityTag);
+			FGameplayTagContainer DashAbilityTags(PLGameplayTags::Ability_Movement_Dash);
 			AbilitySystemComponent->CancelAbilities(&DashAbilityTags);
 		}
-		else if (AbilitySystemComponent->HasMatchingGameplayTag(DoubleDashAbilityTag))
+		else if (AbilitySystemComponent->HasMatchingGameplayTag(PLGameplayTags::Ability_Movement_DoubleDash))
 		{
-			FGameplayTagContainer DoubleDashAbilityTags(DoubleDashAbilityTag);
+			FGameplayTagContainer DoubleDashAbilityTags(PLGameplayTags::Ability_Movement_DoubleDash);
 			AbilitySystemComponent->CancelAbilities(&DoubleDashAbilityTags);
 		}
 
 		// activate Dash if possible, else try to use the DoubleDash
-		if (AbilitySystemComponent->TryActivateAbilitiesByTag(FGameplayTagContainer(DashAbilityTag)) == false)
+		if (AbilitySystemComponent->TryActivateAbilitiesByTagCached(FGameplayTagContainer(PLGameplayTags::Ability_Movement_Dash)) == false)
 		{
-			AbilitySystemComponent->TryActivateAbilitiesByTag(FGameplayTagContainer(DoubleDashAbilityTag));
+			AbilitySystemComponent->TryActivateAbilitiesByTagCached(FGameplayTagContainer(PLGameplayTags::Ability_Movement_DoubleDash));
 		}
 	}
 }
@@ -263,7 +283,7 @@ void APLCharacter::QuickStepPress()
 		UCharacterMovementComponent *CharacterMovementComponent = GetCharacterMovement();
 		if (CharacterMovementComponent && !CharacterMovementComponent->IsFalling())
 		{
-			AbilitySystemComponent->TryActivateAbilitiesByTag(FGameplayTagContainer(QuickStepAbilityTag));
+			AbilitySystemComponent->TryActivateAbilitiesByTagCached(FGameplayTagContainer(PLGameplayTags::Ability_Movement_QuickStep));
 		}
 	}
 }
@@ -276,7 +296,7 @@ void APLCharacter::GlidePress()
 	{
 		if (AbilitySystemComponent && CharacterMovementComponent && CharacterMovementComponent->IsFalling())
 		{
-			if (AbilitySystemComponent->TryActivateAbilitiesByTag(FGameplayTagContainer{GlideAbilityTag}))
+			if (AbilitySystemComponent->TryActivateAbilitiesByTagCached(FGameplayTagContainer{PLGameplayTags::Ability_Movement_Glide}))
 			{
 				// we want to cancel the jump when the player is still holding the jump key, while trying to perform the Glide
 				StopJumping();
@@ -287,7 +307,7 @@ void APLCharacter::GlidePress()
 
 bool APLCharacter::TryCancelGlideAbility()
 {
-	FGameplayTagContainer GlideAbilityTagContainer{GlideAbilityTag};
+	FGameplayTagContainer GlideAbilityTagContainer{PLGameplayTags::Ability_Movement_Glide};
 
 	if (AbilitySystemComponent->HasAnyMatchingGameplayTags(GlideAbilityTagContainer))
 	{
@@ -303,7 +323,7 @@ void APLCharacter::AttackPress()
 	if (AbilitySystemComponent)
 	{
 		// try to set up combo if attack ability is active and the AnimNotify enabled the combo; else activate the abiltiy
-		if (AbilitySystemComponent->HasMatchingGameplayTag(AttackAbilityTag))
+		if (AbilitySystemComponent->HasMatchingGameplayTag(PLGameplayTags::Ability_Combat_Attack))
 		{
 			if (bAttackAbilityComboEnabled)
 			{
@@ -316,7 +336,7 @@ void APLCharacter::AttackPress()
 		}
 		else
 		{
-			AbilitySystemComponent->TryActivateAbilitiesByTag(FGameplayTagContainer(AttackAbilityTag));
+			AbilitySystemComponent->TryActivateAbilitiesByTagCached(FGameplayTagContainer(PLGameplayTags::Ability_Combat_Attack));
 		}
 	}
 }
@@ -333,12 +353,50 @@ EPLMovementSpaceState APLCharacter::GetMovementSpaceState() const
 
 void APLCharacter::SetMovementSpaceState(EPLMovementSpaceState State)
 {
+	FPLMovementSpaceTransition Transition{};
+	Transition.MovementSpace = State;
+	ApplyMovementSpaceTransition(Transition);
+}
+
+void APLCharacter::ApplyMovementSpaceTransition(const FPLMovementSpaceTransition &Transition)
+{
+	// an applied transition supersedes the requested one
+	bMovementSpaceTransitionPending = false;
+
+	if (Transition.MovementSpline)
+	{
+		MovementSplineComponentFromWorld = Transition.MovementSpline;
+	}
 	PreviousMovementSpace = MovementSpace;
-	MovementSpace = State;
+	MovementSpace = Transition.MovementSpace;
+	UpdateMovementSplineConstraint();
+
+	if (Transition.Camera)
+	{
+		if (APlayerController *PossessingPlayerController = Cast<APlayerController>(GetController()); PossessingPlayerController && (PossessingPlayerController->GetViewTarget() != Transition.Camera))
+		{
+			const FPLMovementSpaceProfile &Profile{FPLMovementSpaceProfile::Get(MovementSpace)};
+			FViewTargetTransitionParams TransitionParams{};
+			if (!Transition.bCutToCamera)
+			{
+				TransitionParams.BlendTime = Profile.CameraBlendTime;
+				TransitionParams.BlendFunction = Profile.CameraBlendFunction;
+				TransitionParams.BlendExp = Profile.CameraBlendExp;
+			}
+			PossessingPlayerController->SetViewTarget(Transition.Camera, TransitionParams);
+		}
+	}
 
 	OnMovementSpaceStateChanged();
 }
 
+void APLCharacter::RequestMovementSpaceTransition(const FPLMovementSpaceTransition &Transition)
+{
+	PendingMovementSpaceTransition = Transition;
+	bMovementSpaceTransitionPending = true;
+	MovementSpaceTransitionRequestTime = GetWorld()->GetTimeSeconds();
+}
+
 EPLMovementSpaceState APLCharacter::GetPreviousMovementSpaceState() const
 {
 	return PreviousMovementSpace;
@@ -352,6 +410,8 @@ const USplineComponent *APLCharacter::GetMovementSplineComponent()
 void APLCharacter::SetMovementSpline(USplineComponent const *MovementSplineComponent)
 {
 	MovementSplineComponentFromWorld = MovementSplineComponent;
+
+	UpdateMovementSplineConstraint();
 }
 
 void APLCharacter::ActivateAttackAbilityCombo(FName ComboNextSectionName)
@@ -366,11 +426,66 @@ void APLCharacter::DeactivateAttackAbilityCombo()
 	AttackAbilityNextSectionCombo = "COMBODEACTIVATED";
 }
 
+void APLCharacter::Respawn(const FTransform &SpawnTransform, const FPLMovementSpaceTransition &SpawnTransition)
+{
+	if (AbilitySystemComponent)
+	{
+		// end all abilities and remove the death and cooldown states
+		AbilitySystemComponent->CancelAllAbilities();
+		AbilitySystemComponent->SetLooseGameplayTagCount(PLGameplayTags::Status_Dead, 0);
+		FGameplayTagContainer RespawnRemovedEffectTags{PLGameplayTags::Status_Dead};
+		RespawnRemovedEffectTags.AddTag(PLGameplayTags::Cooldown);
+		AbilitySystemComponent->RemoveActiveEffectsWithGrantedTags(RespawnRemovedEffectTags);
+		AbilitySystemComponent->ClearAbilityBlocks();
+
+		SpawnAttributeSnapshot.Restore(*AbilitySystemComponent);
+
+		for (const FGameplayAbilitySpecHandle &PassiveAbilitySpecHandle : PassiveAbilitySpecHandles)
+		{
+			AbilitySystemComponent->TryActivateAbility(PassiveAbilitySpecHandle);
+		}
+	}
+
+	if (MeleeHitComponent)
+	{
+		MeleeHitComponent->EndSwing();
+	}
+
+	// leave a wall slide and reset the movement, since the WallSlide ability was already canceled
+	if (AActor *WallActor = LastValidWallSlideHitResult.GetActor(); WallActor && (GetAttachParentActor() == WallActor))
+	{
+		DetachFromActor(FDetachmentTransformRules{EDetachmentRule::KeepWorld, false});
+	}
+	bWallSlidingFlag = false;
+	if (UPLCharacterMovementComponent *CharacterMovementComponent = GetPLCharacterMovement(); CharacterMovementComponent)
+	{
+		CharacterMovementComponent->StopMovementImmediately();
+		CharacterMovementComponent->ResetGravityScaleOverrides();
+	}
+
+	TeleportToSpawn(SpawnTransform, SpawnTransition);
+
+	Respawned();
+}
+
+void APLCharacter::TeleportToSpawn(const FTransform &SpawnTransform, const FPLMovementSpaceTransition &SpawnTransition)
+{
+	// the camera is not blended across the teleport
+	FPLMovementSpaceTransition CutTransition{SpawnTransition};
+	CutTransition.bCutToCamera = true;
+	ApplyMovementSpaceTransition(CutTransition);
+	TeleportTo(SpawnTransform.GetLocation(), SpawnTransform.Rotator(), false, true);
+	if (AController *PossessingController = GetController(); PossessingController)
+	{
+		PossessingController->SetControlRotation(SpawnTransform.Rotator());
+	}
+}
+
 bool APLCharacter::IsDead()
 {
 	if (AbilitySystemComponent)
 	{
-		return AbilitySystemComponent->HasMatchingGameplayTag(DeadTag);
+		return AbilitySystemComponent->HasMatchingGameplayTag(PLGameplayTags::Status_Dead);
 	}
 	else
 	{
@@ -381,11 +496,21 @@ bool APLCharacter::IsDead()
 
 void APLCharacter::BeginPlay()
 {
+	LLM_SCOPE_BYTAG(ProjectLux_Character);
 	Super::BeginPlay();
 }
 
+void APLCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	AbilitySystemDelegateBindings.UnbindAll();
+
+	Super::EndPlay(EndPlayReason);
+}
+
 void APLCharacter::UpdateWallSlidingFlag()
 {
+	PL_SCOPE_HITCH_STAGE(CharacterWallSlide);
+
 	UCharacterMovementComponent *CharacterMovementComponent = GetCharacterMovement();
 
 	if (CharacterMovementComponent && CharacterMovementComponent->IsFalling() && IsTouchingWallForWallSlide() && (CharacterMovementComponent->Velocity.Z <= 0.0f))
@@ -408,7 +533,7 @@ void APLCharacter::SetWallSlidingFlag(bool bFlagValue)
 void APLCharacter::OnWallSlidingFlagSet()
 {
 	FGameplayTagContainer WallSlideTags;
-	WallSlideTags.AddTag(WallSlideAbilityTag);
+	WallSlideTags.AddTag(PLGameplayTags::Ability_Movement_WallSlide);
 
 	if (GetWallSlidingFlag() == true)
 	{
@@ -419,7 +544,7 @@ void APLCharacter::OnWallSlidingFlagSet()
 			{
 				// the wall slide ability is more of a passive ability and its behavior is following here
 				// -> passive means that is interacts with other abilites, but not directly (in the Blueprint) doing anything
-				UCharacterMovementComponent *CharacterMovementComponent = GetCharacterMovement();
+				UPLCharacterMovementComponent *CharacterMovementComponent = GetPLCharacterMovement();
 				if (CharacterMovementComponent)
 				{
 					AController *PossessingController = GetController();
@@ -434,7 +559,7 @@ void APLCharacter::OnWallSlidingFlagSet()
 						if (WallActor && (GetAttachParentActor() != WallActor))
 						{
 							AttachToActor(WallActor, FAttachmentTransformRules{EAttachmentRule::KeepWorld, false});
-							CharacterMovementComponent->GravityScale = 0.0f;
+							CharacterMovementComponent->PushGravityScaleOverride(EPLGravityScaleOverrideSource::WallSlide, 0.0f);
 							CharacterMovementComponent->Velocity = FVector(0.0f, 0.0f, 0.0f);
 							// push character to the wall, so he does not hover in front it
 							FHitResult WallPushHitResult{};
@@ -445,7 +570,7 @@ void APLCharacter::OnWallSlidingFlagSet()
 			}
 			else
 			{
-				AbilitySystemComponent->TryActivateAbilitiesByTag(WallSlideTags);
+				AbilitySystemComponent->TryActivateAbilitiesByTagCached(WallSlideTags);
 			}
 		}
 	}
@@ -458,18 +583,15 @@ void APLCharacter::OnWallSlidingFlagSet()
 			{
 				AbilitySystemComponent->CancelAbilities(&WallSlideTags);
 
-				UCharacterMovementComponent *CharacterMovementComponent = GetCharacterMovement();
+				UPLCharacterMovementComponent *CharacterMovementComponent = GetPLCharacterMovement();
 				if (CharacterMovementComponent)
 				{
-					// Do not change the GravityScale to its default value, when the player wants to (Double-)Dash,
-					// since this will affect the GravityScale change in the (Double-)Dash ability
+					// Do not change the GravityScale, when the player wants to (Double-)Dash,
+					// since the (Double-)Dash ability writes the GravityScale directly (it is not stacked until its Blueprint is migrated) and this would affect its change
 					FGameplayTagContainer DashAbilityTags;
-					DashAbilityTags.AddTag(DashAbilityTag);
-					DashAbilityTags.AddTag(DoubleDashAbilityTag);
-					if (AbilitySystemComponent->HasAnyMatchingGameplayTags(DashAbilityTags) == false)
-					{
-						CharacterMovementComponent->GravityScale = DefaultCharacterMovementComponentGravityScale;
-					}
+					DashAbilityTags.AddTag(PLGameplayTags::Ability_Movement_Dash);
+					DashAbilityTags.AddTag(PLGameplayTags::Ability_Movement_DoubleDash);
+					CharacterMovementComponent->PopGravityScaleOverride(EPLGravityScaleOverrideSource::WallSlide, !AbilitySystemComponent->HasAnyMatchingGameplayTags(DashAbilityTags));
 				}
 				AActor *WallActor = LastValidWallSlideHitResult.GetActor();
 				if (WallActor && (GetAttachParentActor() == WallActor))
@@ -481,47 +603,36 @@ void APLCharacter::OnWallSlidingFlagSet()
 	}
 }
 
+bool APLCharacter::IsMovementSpaceTransitionApplied(const FPLMovementSpaceTransition &Transition) const
+{
+	if ((MovementSpace != Transition.MovementSpace) || (Transition.MovementSpline && (Transition.MovementSpline != MovementSplineComponentFromWorld)))
+	{
+		return false;
+	}
+
+	if (Transition.Camera)
+	{
+		const APlayerController *PossessingPlayerController = Cast<APlayerController>(GetController());
+		return !PossessingPlayerController || (PossessingPlayerController->GetViewTarget() == Transition.Camera);
+	}
+
+	return true;
+}
+
 void APLCharacter::OnMovementSpaceStateChanged()
 {
 	if (MovementSpace != PreviousMovementSpace)
 	{
-		// restrict the movement of the character
+		// restrict the movement of the character, but only reconfigure the plane constraint if the profiles differ
+		const FPLMovementSpaceProfile &Profile{FPLMovementSpaceProfile::Get(MovementSpace)};
 		UCharacterMovementComponent *CharacterMovementComponent = GetCharacterMovement();
-		if (CharacterMovementComponent)
+		if (CharacterMovementComponent && !Profile.HasEqualPlaneConstraint(FPLMovementSpaceProfile::Get(PreviousMovementSpace)))
 		{
-			switch (MovementSpace)
+			if (Profile.bPlaneConstraintEnabled)
 			{
-			case EPLMovementSpaceState::MovementIn2D:
-				switch (PreviousMovementSpace)
-				{
-				case EPLMovementSpaceState::MovementIn2D:
-					break;
-				case EPLMovementSpaceState::MovementIn3D:
-				case EPLMovementSpaceState::MovementOnSpline:
-					CharacterMovementComponent->SetPlaneConstraintEnabled(true);
-					CharacterMovementComponent->SetPlaneConstraintAxisSetting(EPlaneConstraintAxisSetting::X);
-					break;
-				default:
-					break;
-				}
-				break;
-			case EPLMovementSpaceState::MovementIn3D:
-			case EPLMovementSpaceState::MovementOnSpline:
-				switch (PreviousMovementSpace)
-				{
-				case EPLMovementSpaceState::MovementIn2D:
-					CharacterMovementComponent->SetPlaneConstraintEnabled(false);
-					break;
-				case EPLMovementSpaceState::MovementIn3D:
-				case EPLMovementSpaceState::MovementOnSpline:
-					break;
-				default:
-					break;
-				}
-				break;
-			default:
-				break;
+				CharacterMovementComponent->SetPlaneConstraintAxisSetting(Profile.PlaneConstraintAxisSetting);
 			}
+			CharacterMovementComponent->SetPlaneConstraintEnabled(Profile.bPlaneConstraintEnabled);
 		}
 
 		// call the event of the MovementSpaceState change, so that designers can react to the change
@@ -529,6 +640,20 @@ void APLCharacter::OnMovementSpaceStateChanged()
 	}
 }
 
+void APLCharacter::UpdateMovementSplineConstraint()
+{
+	if (UPLCharacterMovementComponent *CharacterMovementComponent = GetPLCharacterMovement(); CharacterMovementComponent)
+	{
+		CharacterMovementComponent->SetMovementSpline(FPLMovementSpaceProfile::Get(MovementSpace).bConstrainToSpline ? MovementSplineComponentFromWorld : nullptr);
+	}
+}
+
+FVector APLCharacter::GetMovementSplineDirection() const
+{
+	const UPLCharacterMovementComponent *CharacterMovementComponent = GetPLCharacterMovement();
+	return CharacterMovementComponent ? CharacterMovementComponent->GetMovementSplineDirection() : FVector::ZeroVector;
+}
+
 void APLCharacter::OnHealthChanged(FOnAttributeChangeData const &Data)
 {
 	HealthChanged(Data.OldValue, Data.NewValue);
@@ -566,7 +691,14 @@ TOptional<FHitResult> APLCharacter::IsTouchingWallForWallSlide()
 	FHitResult OutWallHit{};
 	FVector LineTraceStart = GetActorLocation();
 	FVector LineTraceEnd = LineTraceStart + (GetActorForwardVector() * (GetCapsuleComponent()->GetScaledCapsuleRadius() * 1.5f));
-	ECollisionChannel LineTraceChannel{ECollisionChannel::ECC_GameTraceChannel1}; // Wallslide Trace Channel
+
+	// the trace is only needed to confirm a wall, which the baked wall grid reports near the Character
+	if (UPLWallProximitySubsystem *WallProximitySubsystem = GetWorld()->GetSubsystem<UPLWallProximitySubsystem>(); WallProximitySubsystem && !WallProximitySubsystem->MayHitWall(LineTraceStart, LineTraceEnd))
+	{
+		return TOptional<FHitResult>{};
+	}
+
+	ECollisionChannel LineTraceChannel{UPLWallProximitySubsystem::WallSlideTraceChannel};
 	FCollisionQueryParams CollisionParams{};
 	CollisionParams.AddIgnoredActor(this);
 
@@ -592,7 +724,7 @@ FVector APLCharacter::GetMoveDirectionFromMoveInput(const FVector2D MoveInputVec
 		case EPLMovementSpaceState::MovementOnSpline:
 			if (MovementSplineComponentFromWorld)
 			{
-				MovementDirection = MoveInputVector.Y * MovementSplineComponentFromWorld->FindTangentClosestToWorldLocation(GetRootComponent()->GetComponentLocation(), ESplineCoordinateSpace::World);
+				MovementDirection = MoveInputVector.Y * GetMovementSplineDirection();
 			}
 			break;
 		default:
@@ -671,7 +803,7 @@ void APLCharacter::UpdateRotationToMoveDirection(FVector MovementDirection)
 		FRotator DesiredRotationFromInput(0.0f, 0.0f, 0.0f);
 		float DeltaSeconds = World->GetDeltaSeconds();
 		float RotationRateYaw = CharacterMovementComponent->RotationRate.Yaw;
-		const bool WallSlideAbilityActive{AbilitySystemComponent->HasAnyMatchingGameplayTags(FGameplayTagContainer(WallSlideAbilityTag))};
+		const bool WallSlideAbilityActive{AbilitySystemComponent->HasAnyMatchingGameplayTags(FGameplayTagContainer(PLGameplayTags::Ability_Movement_WallSlide))};
 		// Calculate the desired rotation depending on the input and "movement space state":
 		switch (MovementSpace)
 		{
@@ -706,10 +838,8 @@ void APLCharacter::UpdateRotationToMoveDirection(FVector MovementDirection)
 		case EPLMovementSpaceState::MovementOnSpline:
 			if ((MovementDirection.Y != 0.0f) && MovementSplineComponentFromWorld)
 			{
-				FVector CharacterWorldLocation = GetRootComponent()->GetComponentLocation();
-				// We only want to find the closest rotation on the spline in the XY plane, since the Character can move freely in the Z direction.
 				// Note: We later only need the Yaw-value for the rotation.
-				FRotator ClosestWorldRotationOnSpline = MovementSplineComponentFromWorld->FindRotationClosestToWorldLocation(FVector{CharacterWorldLocation.X, CharacterWorldLocation.Y, 0.0f}, ESplineCoordinateSpace::World);
+				FRotator ClosestWorldRotationOnSpline = GetMovementSplineDirection().Rotation();
 
 				// If the Character should go "left" rotate him by 180-degrees to face in the left direction.
 				if (MovementDirection.Y < 0.0f)
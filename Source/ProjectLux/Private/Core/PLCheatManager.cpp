@@ -2,8 +2,351 @@
 
 #include "Core/PLCheatManager.h"
 
+#include "Components/SplineComponent.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/PlayerStart.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+
+#include "Core/Benchmark/PLMemoryReport.h"
+#include "Core/Component/ChaseActorAlongSpline/PLChaseActorAlongSplineComponent.h"
+#include "Core/PLEnemyCharacterBase.h"
+#include "Core/Subsystem/PLHitchDetectorSubsystem.h"
+#include "Core/Subsystem/PLPlayerStartSubsystem.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogPLCheatManager, Log, All);
+
+const FString UPLCheatManager::FastPathPrefix{TEXT("projectlux.FastPath.")};
+
 void UPLCheatManager::TeleportToPlayerStart_Implementation(FName PlayerStartTag)
 {
-    static_cast<void>(PlayerStartTag);
-    GEngine->AddOnScreenDebugMessage(-1, 5.0f, FColor::Yellow, TEXT("TeleportToPlayerStart command not implemented. Expecting implementation in Blueprint."));
+    APlayerController *PlayerController = GetPlayerController();
+    const UPLPlayerStartSubsystem *PlayerStartSubsystem = GetWorld()->GetSubsystem<UPLPlayerStartSubsystem>();
+    if (!PlayerController || !PlayerStartSubsystem)
+    {
+        return;
+    }
+
+    // without a tag we use the PlayerStart of the last spawn (i.e. the last checkpoint)
+    if (PlayerStartTag.IsNone())
+    {
+        if (const APlayerStart *LastPlayerStart = Cast<APlayerStart>(PlayerController->StartSpot.Get()); LastPlayerStart)
+        {
+            PlayerStartTag = LastPlayerStart->PlayerStartTag;
+        }
+    }
+
+    if (!PlayerStartSubsystem->TeleportToPlayerStart(PlayerController, PlayerStartTag))
+    {
+        GEngine->AddOnScreenDebugMessage(-1, 5.0f, FColor::Yellow, FString::Printf(TEXT("TeleportToPlayerStart: No PlayerStart with the tag %s found."), *PlayerStartTag.ToString()));
+    }
+}
+
+void UPLCheatManager::SpawnEnemyGrid(const FString &EnemyClassName, int32 Count, float Spacing)
+{
+    PL_SCOPE_HITCH_STAGE(Spawn);
+
+    const APawn *Player = GetPlayerController() ? GetPlayerController()->GetPawn() : nullptr;
+    UClass *EnemyClass = FindActorClass(EnemyClassName, APLEnemyCharacterBase::StaticClass());
+    if (!Player || !EnemyClass || (Count <= 0))
+    {
+        PrintMessage(FString::Printf(TEXT("SpawnEnemyGrid: No player or no APLEnemyCharacterBase class named %s found."), *EnemyClassName), FColor::Yellow);
+        return;
+    }
+
+    // the grid is centered on the player, whose cell stays empty
+    const float CellSize{(Spacing > 0.0f) ? Spacing : DefaultGridSpacing};
+    const int32 GridSize{FMath::CeilToInt32(FMath::Sqrt(static_cast<float>(Count + 1)))};
+    const int32 PlayerCell{(GridSize / 2) * GridSize + (GridSize / 2)};
+    const FVector GridOrigin{Player->GetActorLocation()};
+
+    FActorSpawnParameters SpawnParameters{};
+    SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+    int32 NumSpawned{0};
+    for (int32 Cell = 0; (Cell < GridSize * GridSize) && (NumSpawned < Count); ++Cell)
+    {
+        if (Cell == PlayerCell)
+        {
+            continue;
+        }
+
+        const FVector Offset{((Cell % GridSize) - (GridSize / 2)) * CellSize, ((Cell / GridSize) - (GridSize / 2)) * CellSize, 0.0f};
+        if (APawn *Enemy = GetWorld()->SpawnActor<APawn>(EnemyClass, GridOrigin + Offset, FRotator::ZeroRotator, SpawnParameters); Enemy)
+        {
+            if (!Enemy->GetController())
+            {
+                Enemy->SpawnDefaultController();
+            }
+            StressActors.Add(Enemy);
+            ++NumSpawned;
+        }
+    }
+
+    StartFrameTimeSummary(FString::Printf(TEXT("SpawnEnemyGrid %s x%d (%d stress actors)"), *EnemyClass->GetName(), NumSpawned, StressActors.Num()));
+}
+
+void UPLCheatManager::SpawnOnSpline(const FString &ActorClassName, FName SplineActorName, int32 Count)
+{
+    PL_SCOPE_HITCH_STAGE(Spawn);
+
+    UClass *ActorClass = FindActorClass(ActorClassName, AActor::StaticClass());
+    AActor *SplineActor{nullptr};
+    const USplineComponent *Spline{nullptr};
+    for (TActorIterator<AActor> ActorIt{GetWorld()}; ActorIt; ++ActorIt)
+    {
+        if ((ActorIt->ActorHasTag(SplineActorName) || (ActorIt->GetFName() == SplineActorName)) && ActorIt->FindComponentByClass<USplineComponent>())
+        {
+            SplineActor = *ActorIt;
+            Spline = SplineActor->FindComponentByClass<USplineComponent>();
+            break;
+        }
+    }
+    if (!ActorClass || !Spline || (Count <= 0))
+    {
+        PrintMessage(FString::Printf(TEXT("SpawnOnSpline: No actor class named %s or no spline actor named %s found."), *ActorClassName, *SplineActorName.ToString()), FColor::Yellow);
+        return;
+    }
+
+    FActorSpawnParameters SpawnParameters{};
+    SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+    const float SplineLength{Spline->GetSplineLength()};
+    int32 NumSpawned{0};
+    for (int32 SpawnIndex = 0; SpawnIndex < Count; ++SpawnIndex)
+    {
+        const float Distance{SplineLength * (SpawnIndex + 0.5f) / Count};
+        const FTransform SpawnTransform{Spline->GetTransformAtDistanceAlongSpline(Distance, ESplineCoordinateSpace::World, false)};
+        if (AActor *SpawnedActor = GetWorld()->SpawnActor<AActor>(ActorClass, SpawnTransform, SpawnParameters); SpawnedActor)
+        {
+            // the chase component resolved its spline on the begin of play, before the actor was attached to the spline actor
+            SpawnedActor->AttachToActor(SplineActor, FAttachmentTransformRules::KeepWorldTransform);
+            if (UPLChaseActorAlongSplineComponent *ChaseComponent = SpawnedActor->FindComponentByClass<UPLChaseActorAlongSplineComponent>(); ChaseComponent)
+            {
+                ChaseComponent->RefreshSplines();
+            }
+            StressActors.Add(SpawnedActor);
+            ++NumSpawned;
+        }
+    }
+
+    StartFrameTimeSummary(FString::Printf(TEXT("SpawnOnSpline %s x%d on %s (%d stress actors)"), *ActorClass->GetName(), NumSpawned, *SplineActor->GetName(), StressActors.Num()));
+}
+
+void UPLCheatManager::DestroyStressActors()
+{
+    for (const TWeakObjectPtr<AActor> &StressActor : StressActors)
+    {
+        if (AActor *Actor = StressActor.Get(); Actor)
+        {
+            // the default controllers of the enemies would stay behind
+            if (const APawn *Pawn = Cast<APawn>(Actor); Pawn && Pawn->GetController() && !Pawn->GetController()->IsPlayerController())
+            {
+                Pawn->GetController()->Destroy();
+            }
+            Actor->Destroy();
+        }
+    }
+    StressActors.Reset();
+
+    StartFrameTimeSummary(TEXT("DestroyStressActors"));
+}
+
+void UPLCheatManager::SetFastPath(const FString &FastPathName, bool bEnabled)
+{
+    IConsoleVariable *FastPathVariable = IConsoleManager::Get().FindConsoleVariable(*(FastPathPrefix + FastPathName));
+    if (!FastPathVariable)
+    {
+        PrintMessage(FString::Printf(TEXT("SetFastPath: No fast path named %s found."), *FastPathName), FColor::Yellow);
+        ListFastPaths();
+        return;
+    }
+
+    FastPathVariable->Set(bEnabled, ECVF_SetByCheat);
+
+    StartFrameTimeSummary(FString::Printf(TEXT("SetFastPath %s %s"), *FastPathName, bEnabled ? TEXT("on") : TEXT("off")));
+}
+
+void UPLCheatManager::ListFastPaths()
+{
+    const FConsoleObjectVisitor PrintFastPath = FConsoleObjectVisitor::CreateLambda([](const TCHAR *Name, IConsoleObject *ConsoleObject)
+    {
+        if (const IConsoleVariable *FastPathVariable = ConsoleObject->AsVariable(); FastPathVariable)
+        {
+            PrintMessage(FString::Printf(TEXT("%s = %s"), Name, FastPathVariable->GetBool() ? TEXT("on") : TEXT("off")));
+        }
+    });
+    IConsoleManager::Get().ForEachConsoleObjectThatStartsWith(PrintFastPath, *FastPathPrefix);
+
+    StartFrameTimeSummary(TEXT("ListFastPaths"));
+}
+
+void UPLCheatManager::FrameTimeSummary(int32 NumFrames)
+{
+    StartFrameTimeSummary(TEXT("FrameTimeSummary"), (NumFrames > 0) ? NumFrames : DefaultNumSummaryFrames);
+}
+
+void UPLCheatManager::InspectHitchDump(const FString &DumpFileName)
+{
+    FString DumpFilePath{DumpFileName.IsEmpty() ? UPLHitchDetectorSubsystem::FindLatestDumpFile() : DumpFileName};
+    if (!DumpFilePath.IsEmpty() && FPaths::IsRelative(DumpFilePath) && !FPaths::FileExists(DumpFilePath))
+    {
+        DumpFilePath = UPLHitchDetectorSubsystem::GetDumpDirectory() / DumpFilePath;
+    }
+
+    FPLHitchDump Dump{};
+    if (DumpFilePath.IsEmpty() || !UPLHitchDetectorSubsystem::ReadDumpFile(DumpFilePath, Dump) || Dump.Frames.IsEmpty())
+    {
+        PrintMessage(FString::Printf(TEXT("InspectHitchDump: No valid hitch dump %s found in %s."), *DumpFileName, *UPLHitchDetectorSubsystem::GetDumpDirectory()), FColor::Yellow);
+        return;
+    }
+
+    const UEnum *StageEnum = StaticEnum<EPLHitchStage>();
+    constexpr int32 NumStages{static_cast<int32>(EPLHitchStage::Num)};
+
+    // the last frame of a dump is the hitch
+    const FPLHitchFrame &HitchFrame = Dump.Frames.Last();
+    PrintMessage(FString::Printf(TEXT("%s: %d frames, hitch frame %llu took %.2f ms (budget %.2f ms)"), *FPaths::GetCleanFilename(DumpFilePath), Dump.Frames.Num(), HitchFrame.FrameNumber, HitchFrame.FrameTime, Dump.FrameBudget), FColor::Green);
+
+    TArray<int32, TInlineAllocator<NumStages>> StageIndices{};
+    for (int32 StageIndex = 0; StageIndex < NumStages; ++StageIndex)
+    {
+        StageIndices.Add(StageIndex);
+    }
+    StageIndices.Sort([&HitchFrame](int32 A, int32 B)
+                      { return HitchFrame.StageTimes[A] > HitchFrame.StageTimes[B]; });
+
+    // the stages of the hitch frame compared to their average and maximum over all recorded frames
+    for (const int32 StageIndex : StageIndices)
+    {
+        float StageTimeSum{0.0f};
+        float MaxStageTime{0.0f};
+        for (const FPLHitchFrame &Frame : Dump.Frames)
+        {
+            StageTimeSum += Frame.StageTimes[StageIndex];
+            MaxStageTime = FMath::Max(MaxStageTime, Frame.StageTimes[StageIndex]);
+        }
+        if (MaxStageTime > 0.0f)
+        {
+            PrintMessage(FString::Printf(TEXT("  %s: %.2f ms (%d runs) in the hitch, avg %.2f ms, max %.2f ms"), *StageEnum->GetNameStringByValue(StageIndex), HitchFrame.StageTimes[StageIndex],
+                                         HitchFrame.StageCounts[StageIndex], StageTimeSum / Dump.Frames.Num(), MaxStageTime));
+        }
+    }
+
+    TArray<const FPLHitchFrame *> SlowestFrames{};
+    for (const FPLHitchFrame &Frame : Dump.Frames)
+    {
+        SlowestFrames.Add(&Frame);
+    }
+    SlowestFrames.Sort([](const FPLHitchFrame &A, const FPLHitchFrame &B)
+                       { return A.FrameTime > B.FrameTime; });
+    for (int32 FrameIndex = 0; FrameIndex < FMath::Min(NumInspectedSlowestFrames, SlowestFrames.Num()); ++FrameIndex)
+    {
+        PrintMessage(FString::Printf(TEXT("  slow frame %llu: %.2f ms"), SlowestFrames[FrameIndex]->FrameNumber, SlowestFrames[FrameIndex]->FrameTime));
+    }
+}
+
+void UPLCheatManager::MemoryReport()
+{
+    UWorld *World = GetWorld();
+    if (!World)
+    {
+        return;
+    }
+
+    const FPLMemoryReport Report{FPLMemoryReport::Gather(*World)};
+    PrintMessage(TEXT("MemoryReport:"), FColor::Green);
+    for (const FString &Line : Report.ToLines())
+    {
+        PrintMessage(Line);
+    }
+}
+
+void UPLCheatManager::BeginDestroy()
+{
+    FTSTicker::GetCoreTicker().RemoveTicker(FrameTimeTickerHandle);
+    FrameTimeTickerHandle.Reset();
+
+    Super::BeginDestroy();
+}
+
+UClass *UPLCheatManager::FindActorClass(const FString &ClassName, const UClass *BaseClass)
+{
+    // loaded classes are found by their name, others have to be given by their object path
+    UClass *ActorClass = FindFirstObject<UClass>(*ClassName, EFindFirstObjectOptions::None, ELogVerbosity::NoLogging);
+    if (!ActorClass && FPackageName::IsValidObjectPath(ClassName))
+    {
+        ActorClass = LoadObject<UClass>(nullptr, *ClassName);
+    }
+
+    return (ActorClass && ActorClass->IsChildOf(BaseClass) && !ActorClass->HasAnyClassFlags(CLASS_Abstract)) ? ActorClass : nullptr;
+}
+
+void UPLCheatManager::StartFrameTimeSummary(const FString &Label, int32 NumFrames)
+{
+    FTSTicker::GetCoreTicker().RemoveTicker(FrameTimeTickerHandle);
+
+    FrameTimeLabel = Label;
+    NumFrameTimeFrames = NumFrames;
+    FrameTimes.Reset(NumFrames);
+    GameThreadTimes.Reset(NumFrames);
+
+    // the frame of the command itself is skipped, since it contains the spawning
+    FrameTimeTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UPLCheatManager::SampleFrameTime));
+}
+
+bool UPLCheatManager::SampleFrameTime(float DeltaTime)
+{
+    FrameTimes.Add(DeltaTime * 1000.0f);
+    GameThreadTimes.Add(static_cast<float>(FPlatformTime::ToMilliseconds(GGameThreadTime)));
+    if (FrameTimes.Num() < NumFrameTimeFrames)
+    {
+        return true;
+    }
+
+    PrintFrameTimeSummary();
+    return false;
+}
+
+void UPLCheatManager::PrintFrameTimeSummary()
+{
+    FrameTimeTickerHandle.Reset();
+    if (FrameTimes.IsEmpty())
+    {
+        return;
+    }
+
+    TArray<float> SortedFrameTimes{FrameTimes};
+    SortedFrameTimes.Sort();
+    float FrameTimeSum{0.0f};
+    int32 NumHitches{0};
+    for (const float FrameTime : FrameTimes)
+    {
+        FrameTimeSum += FrameTime;
+        NumHitches += (FrameTime > HitchFrameTime) ? 1 : 0;
+    }
+    float GameThreadTimeSum{0.0f};
+    for (const float GameThreadTime : GameThreadTimes)
+    {
+        GameThreadTimeSum += GameThreadTime;
+    }
+
+    const int32 NumFrames{FrameTimes.Num()};
+    const float P95FrameTime{SortedFrameTimes[FMath::Min(FMath::FloorToInt32(NumFrames * 0.95f), NumFrames - 1)]};
+    PrintMessage(FString::Printf(TEXT("%s: %d frames, frame avg %.2f ms, min %.2f ms, p95 %.2f ms, max %.2f ms, game thread avg %.2f ms, %d hitches > %.1f ms"),
+                                 *FrameTimeLabel, NumFrames, FrameTimeSum / NumFrames, SortedFrameTimes[0], P95FrameTime, SortedFrameTimes.Last(), GameThreadTimeSum / NumFrames, NumHitches, HitchFrameTime),
+                 FColor::Green);
+}
+
+void UPLCheatManager::PrintMessage(const FString &Message, const FColor &Color)
+{
+    UE_LOG(LogPLCheatManager, Display, TEXT("%s"), *Message);
+    if (GEngine)
+    {
+        GEngine->AddOnScreenDebugMessage(-1, 10.0f, Color, Message);
+    }
 }
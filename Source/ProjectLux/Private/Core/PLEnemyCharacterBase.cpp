@@ -4,15 +4,22 @@
 
 #include "Abilities/GameplayAbility.h"
 #include "AbilitySystemComponent.h"
+#include "Engine/World.h"
 #include "GameplayEffectTypes.h"
 
+#include "Core/AbilitySystem/PLAbilitySet.h"
 #include "Core/AbilitySystem/PLAbilitySystemComponent.h"
+#include "Core/AbilitySystem/PLGameplayTags.h"
 #include "Core/AbilitySystem/PLCharacterAttributeSet.h"
+#include "Core/Benchmark/PLMemoryTags.h"
+#include "Core/Subsystem/PLEnemyDirectorSubsystem.h"
 
-APLEnemyCharacterBase::APLEnemyCharacterBase() : DeadTag{FGameplayTag::RequestGameplayTag(FName("Status.Dead"))}
+APLEnemyCharacterBase::APLEnemyCharacterBase()
 {
-	// Set this character to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
-	PrimaryActorTick.bCanEverTick = true;
+	LLM_SCOPE_BYTAG(ProjectLux_Enemies);
+
+	// the perception of the player is computed by the UPLEnemyDirectorSubsystem, so the enemy does not need to tick
+	PrimaryActorTick.bCanEverTick = false;
 
 	// Construct the ASC
 	AbilitySystemComponent = CreateDefaultSubobject<UPLAbilitySystemComponent>(TEXT("AbilitySystemComponent"));
@@ -21,9 +28,17 @@ APLEnemyCharacterBase::APLEnemyCharacterBase() : DeadTag{FGameplayTag::RequestGa
 	AttributeSet = CreateDefaultSubobject<UPLCharacterAttributeSet>(TEXT("AttributeSet"));
 }
 
-void APLEnemyCharacterBase::Tick(float DeltaTime)
+void APLEnemyCharacterBase::PostLoad()
 {
-	Super::Tick(DeltaTime);
+	Super::PostLoad();
+
+	// the properties are reset, so that instances copying them from their archetype do not migrate them again
+	if (UPLAbilitySet *MigratedAbilitySet = UPLAbilitySet::CreateFromDeprecatedProperties(*this, DefaultAbilities, {}, {AttributeSetInitEffect}); MigratedAbilitySet)
+	{
+		AbilitySets.Add(MigratedAbilitySet);
+		DefaultAbilities.Reset();
+		AttributeSetInitEffect = nullptr;
+	}
 }
 
 UAbilitySystemComponent *APLEnemyCharacterBase::GetAbilitySystemComponent() const
@@ -31,36 +46,78 @@ UAbilitySystemComponent *APLEnemyCharacterBase::GetAbilitySystemComponent() cons
 	return AbilitySystemComponent;
 }
 
+const FPLAbilitySystemDelegateBindings &APLEnemyCharacterBase::GetAbilitySystemDelegateBindings() const
+{
+	return AbilitySystemDelegateBindings;
+}
+
 void APLEnemyCharacterBase::PossessedBy(AController *NewController)
 {
+	LLM_SCOPE_BYTAG(ProjectLux_Enemies);
 	Super::PossessedBy(NewController);
 
 	AbilitySystemComponent->InitAbilityActorInfo(this, this);
 
-	// add default abilities to ASC
-	for (TSubclassOf<UGameplayAbility> const &DefaultAbility : DefaultAbilities)
-	{
-		AbilitySystemComponent->GiveAbility(FGameplayAbilitySpec(DefaultAbility, 1, -1, this));
-	}
+	// the abilities are not needed before the AI acts, so possession does not wait for the ability sets to be loaded
+	AbilitySetsLoadHandle = UPLAbilitySet::LoadAbilitySetsAsync(AbilitySets, FStreamableDelegate::CreateUObject(this, &APLEnemyCharacterBase::InitializeAbilitySystem));
+}
 
-	// initialize AttributeSet by an instant GameplayEffect (which does exactly this)
-	if (IsValid(AttributeSetInitEffect))
+void APLEnemyCharacterBase::InitializeAbilitySystem()
+{
+	LLM_SCOPE_BYTAG(ProjectLux_Enemies);
+
+	// remove and give again the ability sets, so that a repeated possession does not give the abilities twice
+	AbilitySystemComponent->ClearAllAbilities();
+	TArray<FGameplayAbilitySpecHandle> PassiveAbilitySpecHandles{};
+	for (const UPLAbilitySet *AbilitySet : AbilitySets)
 	{
-		FGameplayEffectContextHandle EffectContext = AbilitySystemComponent->MakeEffectContext();
-		EffectContext.AddSourceObject(this);
-		AbilitySystemComponent->ApplyGameplayEffectToSelf(AttributeSetInitEffect.GetDefaultObject(), 1.0f, EffectContext);
+		if (AbilitySet)
+		{
+			AbilitySet->GiveToAbilitySystem(*AbilitySystemComponent, this, PassiveAbilitySpecHandles);
+		}
 	}
 
-	// add delegates to attribute changes
-	AbilitySystemComponent->GetGameplayAttributeValueChangeDelegate(AttributeSet->GetHealthAttribute()).AddUObject(this, &APLEnemyCharacterBase::OnHealthChanged);
+	// add delegates to attribute changes (the bindings of a previous possession are removed first, so every delegate is bound exactly once)
+	AbilitySystemDelegateBindings.UnbindAll();
+	AbilitySystemDelegateBindings.BindAttributeValueChange(*AbilitySystemComponent, AttributeSet->GetHealthAttribute(), FOnGameplayAttributeValueChange::FDelegate::CreateUObject(this, &APLEnemyCharacterBase::OnHealthChanged));
 
 	// add delegates to GameplayTag changes
-	AbilitySystemComponent->RegisterGameplayTagEvent(DeadTag, EGameplayTagEventType::NewOrRemoved).AddUObject(this, &APLEnemyCharacterBase::OnDeadTagChanged);
+	AbilitySystemDelegateBindings.BindGameplayTagEvent(*AbilitySystemComponent, PLGameplayTags::Status_Dead, EGameplayTagEventType::NewOrRemoved, FOnGameplayEffectTagCountChanged::FDelegate::CreateUObject(this, &APLEnemyCharacterBase::OnDeadTagChanged));
+}
+
+void APLEnemyCharacterBase::UnPossessed()
+{
+	// a pending load must not bind the delegates after the unpossession
+	if (AbilitySetsLoadHandle)
+	{
+		AbilitySetsLoadHandle->CancelHandle();
+		AbilitySetsLoadHandle.Reset();
+	}
+	AbilitySystemDelegateBindings.UnbindAll();
+
+	Super::UnPossessed();
 }
 
 void APLEnemyCharacterBase::BeginPlay()
 {
+	LLM_SCOPE_BYTAG(ProjectLux_Enemies);
 	Super::BeginPlay();
+
+	if (UPLEnemyDirectorSubsystem *EnemyDirectorSubsystem = GetWorld()->GetSubsystem<UPLEnemyDirectorSubsystem>(); EnemyDirectorSubsystem)
+	{
+		EnemyDirectorSubsystem->RegisterEnemy(this);
+	}
+}
+
+void APLEnemyCharacterBase::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UPLEnemyDirectorSubsystem *EnemyDirectorSubsystem = GetWorld()->GetSubsystem<UPLEnemyDirectorSubsystem>(); EnemyDirectorSubsystem)
+	{
+		EnemyDirectorSubsystem->UnregisterEnemy(this);
+	}
+	AbilitySystemDelegateBindings.UnbindAll();
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void APLEnemyCharacterBase::OnHealthChanged(FOnAttributeChangeData const &Data)
@@ -72,7 +129,7 @@ void APLEnemyCharacterBase::HealthChanged_Implementation(float OldValue, float N
 {
 	if (NewValue <= 0.0f)
 	{
-		AbilitySystemComponent->AddLooseGameplayTag(DeadTag);
+		AbilitySystemComponent->AddLooseGameplayTag(PLGameplayTags::Status_Dead);
 	}
 }
 
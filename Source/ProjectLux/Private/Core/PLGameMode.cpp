@@ -1,3 +1,100 @@
 // Copyright TinyAlmonds (Alex Noerdemann)
 
 #include "Core/PLGameMode.h"
+
+#include "Engine/World.h"
+#include "GameFramework/Controller.h"
+#include "GameFramework/PlayerController.h"
+
+#include "Core/AbilitySystem/PLAbilitySet.h"
+#include "Core/PLCharacter.h"
+#include "Core/PLPlayerStart.h"
+#include "Core/Subsystem/PLHitchDetectorSubsystem.h"
+#include "Core/Subsystem/PLPlayerStartSubsystem.h"
+
+void APLGameMode::InitGame(const FString &MapName, const FString &Options, FString &ErrorMessage)
+{
+	Super::InitGame(MapName, Options, ErrorMessage);
+
+	TArray<UPLAbilitySet *> AbilitySets{PreloadedAbilitySets};
+	if (const APLCharacter *DefaultCharacter = Cast<APLCharacter>(DefaultPawnClass ? DefaultPawnClass->GetDefaultObject() : nullptr); DefaultCharacter)
+	{
+		AbilitySets.Append(DefaultCharacter->AbilitySets);
+	}
+
+	AbilitySetsPreloadHandle = UPLAbilitySet::LoadAbilitySetsAsync(AbilitySets, FStreamableDelegate::CreateUObject(this, &APLGameMode::OnAbilitySetsPreloaded));
+}
+
+bool APLGameMode::PlayerCanRestart_Implementation(APlayerController *Player)
+{
+	return bAbilitySetsPreloaded && Super::PlayerCanRestart_Implementation(Player);
+}
+
+void APLGameMode::OnAbilitySetsPreloaded()
+{
+	bAbilitySetsPreloaded = true;
+
+	// players, which joined during the load, were not restarted by HandleStartingNewPlayer()
+	if (UWorld *World = GetWorld(); World && HasMatchStarted())
+	{
+		for (FConstPlayerControllerIterator Iterator = World->GetPlayerControllerIterator(); Iterator; ++Iterator)
+		{
+			if (APlayerController *PlayerController = Iterator->Get(); PlayerController && !PlayerController->GetPawn() && PlayerCanRestart(PlayerController))
+			{
+				RestartPlayer(PlayerController);
+			}
+		}
+	}
+}
+
+bool APLGameMode::RespawnPlayer(AController *Player)
+{
+	PL_SCOPE_HITCH_STAGE(Spawn);
+
+	if (!Player)
+	{
+		return false;
+	}
+
+	AActor *StartSpot = Player->StartSpot.IsValid() ? Player->StartSpot.Get() : FindPlayerStart(Player);
+	APLCharacter *Character = Cast<APLCharacter>(Player->GetPawn());
+	if (!StartSpot || !Character)
+	{
+		RestartPlayer(Player);
+		return false;
+	}
+
+	// without an APLPlayerStart the character keeps its movement space
+	FPLMovementSpaceTransition SpawnTransition{};
+	SpawnTransition.MovementSpace = Character->GetMovementSpaceState();
+	if (APLPlayerStart *PlayerStart = Cast<APLPlayerStart>(StartSpot); PlayerStart)
+	{
+		SpawnTransition = PlayerStart->GetSpawnMovementSpaceTransition();
+	}
+
+	Character->Respawn(FTransform{StartSpot->GetActorRotation(), StartSpot->GetActorLocation()}, SpawnTransition);
+
+	if (APlayerController *PlayerController = Cast<APlayerController>(Player); PlayerController)
+	{
+		PlayerController->EnableInput(PlayerController);
+	}
+
+	return true;
+}
+
+AActor *APLGameMode::FindPlayerStart_Implementation(AController *Player, const FString &IncomingName)
+{
+	if (!IncomingName.IsEmpty())
+	{
+		if (const UPLPlayerStartSubsystem *PlayerStartSubsystem = GetWorld()->GetSubsystem<UPLPlayerStartSubsystem>(); PlayerStartSubsystem)
+		{
+			if (APLPlayerStart *PlayerStart = PlayerStartSubsystem->FindPlayerStart(FName{*IncomingName}); PlayerStart)
+			{
+				return PlayerStart;
+			}
+		}
+	}
+
+	// PlayerStarts, which are not registered yet (e.g. before BeginPlay), are found by the default implementation
+	return Super::FindPlayerStart_Implementation(Player, IncomingName);
+}
@@ -1,6 +1,44 @@
 // Copyright TinyAlmonds (Alex Noerdemann)
 #include "Core/PLPlayerStart.h"
 
+#include "Engine/World.h"
+#include "UObject/ObjectSaveContext.h"
+
+#include "Core/Subsystem/PLPlayerStartSubsystem.h"
+#include "Core/Subsystem/PLSplineLookupSubsystem.h"
+
+void APLPlayerStart::BeginPlay()
+{
+    Super::BeginPlay();
+
+    GetSpawnMovementSplineComponent();
+
+    if (UPLPlayerStartSubsystem *PlayerStartSubsystem = GetWorld()->GetSubsystem<UPLPlayerStartSubsystem>(); PlayerStartSubsystem)
+    {
+        PlayerStartSubsystem->RegisterPlayerStart(this);
+    }
+
+    if (UPLSplineLookupSubsystem *SplineLookupSubsystem = GetWorld()->GetSubsystem<UPLSplineLookupSubsystem>(); SplineLookupSubsystem && MovementSplineComponentFromWorld.IsValid())
+    {
+        SplineLookupSubsystem->RegisterLookupTable(MovementSplineComponentFromWorld.Get(), MovementSplineLookupTable);
+    }
+}
+
+void APLPlayerStart::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (UPLPlayerStartSubsystem *PlayerStartSubsystem = GetWorld()->GetSubsystem<UPLPlayerStartSubsystem>(); PlayerStartSubsystem)
+    {
+        PlayerStartSubsystem->UnregisterPlayerStart(this);
+    }
+
+    if (UPLSplineLookupSubsystem *SplineLookupSubsystem = GetWorld()->GetSubsystem<UPLSplineLookupSubsystem>(); SplineLookupSubsystem)
+    {
+        SplineLookupSubsystem->UnregisterLookupTable(MovementSplineComponentFromWorld.Get(), MovementSplineLookupTable);
+    }
+
+    Super::EndPlay(EndPlayReason);
+}
+
 EPLMovementSpaceState APLPlayerStart::GetSpawnMovementSpaceState() const
 {
     return MovementSpaceSpawn;
@@ -27,3 +65,32 @@ const ACameraActor *APLPlayerStart::GetSpawnCamera()
 {
     return SpawnCamera.Get();
 }
+
+FPLMovementSpaceTransition APLPlayerStart::GetSpawnMovementSpaceTransition()
+{
+    FPLMovementSpaceTransition SpawnTransition{};
+    SpawnTransition.MovementSpace = MovementSpaceSpawn;
+    // the transition needs the mutable spline component, which is resolved by the getter
+    GetSpawnMovementSplineComponent();
+    SpawnTransition.MovementSpline = MovementSplineComponentFromWorld.Get();
+    SpawnTransition.Camera = SpawnCamera.Get();
+
+    return SpawnTransition;
+}
+
+#if WITH_EDITOR
+void APLPlayerStart::PreSave(FObjectPreSaveContext ObjectSaveContext)
+{
+    Super::PreSave(ObjectSaveContext);
+
+    const USplineComponent *SplineComponent = MovementSplineActorSpawn.IsValid() ? MovementSplineActorSpawn.Get()->FindComponentByClass<USplineComponent>() : nullptr;
+    if (SplineComponent && (MovementSpaceSpawn == EPLMovementSpaceState::MovementOnSpline))
+    {
+        MovementSplineLookupTable.Bake(*SplineComponent);
+    }
+    else
+    {
+        MovementSplineLookupTable.Reset();
+    }
+}
+#endif
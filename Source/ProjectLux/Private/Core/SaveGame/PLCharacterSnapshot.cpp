@@ -0,0 +1,190 @@
+// Copyright TinyAlmonds (Alex Noerdemann)
+
+#include "Core/SaveGame/PLCharacterSnapshot.h"
+
+#include "Abilities/GameplayAbility.h"
+#include "AbilitySystemComponent.h"
+#include "Components/SplineComponent.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+#include "Core/AbilitySystem/PLCharacterAttributeSet.h"
+#include "Core/AbilitySystem/PLMovementAttributeSet.h"
+#include "Core/PLCharacter.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogPLCharacterSnapshot, Log, All);
+
+namespace
+{
+	/**
+	 * Returns the attribute layout of the snapshot. Limiting attributes (e.g. MaxHealth) are ordered before the attributes they clamp, since the order is also the restore order.
+	 * @note Adding, removing or reordering attributes changes the layout and requires a new FPLCharacterSnapshot::LayoutVersion.
+	 */
+	const TArray<FGameplayAttribute> &GetAttributeLayout()
+	{
+		static const TArray<FGameplayAttribute> AttributeLayout{
+			UPLCharacterAttributeSet::GetMaxHealthAttribute(),
+			UPLCharacterAttributeSet::GetHealthAttribute(),
+			UPLCharacterAttributeSet::GetRawDamageAttribute(),
+			UPLCharacterAttributeSet::GetArmorAttribute(),
+			UPLCharacterAttributeSet::GetMinEmotionalDamageMultiplierAttribute(),
+			UPLCharacterAttributeSet::GetMinEmotionalResistanceAttribute(),
+			UPLCharacterAttributeSet::GetMaxEmotionalResistanceAttribute(),
+			UPLCharacterAttributeSet::GetFearDamageMultiplierAttribute(),
+			UPLCharacterAttributeSet::GetFearResistanceAttribute(),
+			UPLCharacterAttributeSet::GetAngerDamageMultiplierAttribute(),
+			UPLCharacterAttributeSet::GetAngerResistanceAttribute(),
+			UPLCharacterAttributeSet::GetJoyDamageMultiplierAttribute(),
+			UPLCharacterAttributeSet::GetJoyResistanceAttribute(),
+			UPLCharacterAttributeSet::GetSadnessDamageMultiplierAttribute(),
+			UPLCharacterAttributeSet::GetSadnessResistanceAttribute(),
+			UPLCharacterAttributeSet::GetTrustDamageMultiplierAttribute(),
+			UPLCharacterAttributeSet::GetTrustResistanceAttribute(),
+			UPLCharacterAttributeSet::GetLoathingDamageMultiplierAttribute(),
+			UPLCharacterAttributeSet::GetLoathingResistanceAttribute(),
+			UPLCharacterAttributeSet::GetAnticipationDamageMultiplierAttribute(),
+			UPLCharacterAttributeSet::GetAnticipationResistanceAttribute(),
+			UPLCharacterAttributeSet::GetSupriseDamageMultiplierAttribute(),
+			UPLCharacterAttributeSet::GetSupriseResistanceAttribute(),
+			UPLMovementAttributeSet::GetMaxWalkSpeedAttribute(),
+			UPLMovementAttributeSet::GetJumpZVelocityAttribute(),
+			UPLMovementAttributeSet::GetMaxFallSpeedAttribute(),
+			UPLMovementAttributeSet::GetVelocityMultiplierDashAttribute(),
+			UPLMovementAttributeSet::GetVelocityXYMultiplierWallJumpAttribute(),
+			UPLMovementAttributeSet::GetVelocityZMultiplierWallJumpAttribute(),
+			UPLMovementAttributeSet::GetGravityScaleMultiplierGlideAttribute(),
+			UPLMovementAttributeSet::GetAirControlGlideAttribute()};
+
+		return AttributeLayout;
+	}
+}
+
+FPLCharacterSnapshot FPLCharacterSnapshot::Capture(APLCharacter &Character)
+{
+	FPLCharacterSnapshot Snapshot{};
+
+	if (const UAbilitySystemComponent *AbilitySystemComponent{Character.GetAbilitySystemComponent()}; AbilitySystemComponent)
+	{
+		Snapshot.AttributeBaseValues.Reserve(GetAttributeLayout().Num());
+		for (const FGameplayAttribute &Attribute : GetAttributeLayout())
+		{
+			Snapshot.AttributeBaseValues.Add(AbilitySystemComponent->GetNumericAttributeBase(Attribute));
+		}
+
+		for (const FGameplayAbilitySpec &AbilitySpec : AbilitySystemComponent->GetActivatableAbilities())
+		{
+			if (AbilitySpec.Ability)
+			{
+				Snapshot.AbilityClasses.Emplace(AbilitySpec.Ability->GetClass());
+			}
+		}
+	}
+
+	Snapshot.MovementSpace = Character.GetMovementSpaceState();
+	Snapshot.MovementSplinePath = FSoftObjectPath{Character.GetMovementSplineComponent()};
+
+	return Snapshot;
+}
+
+void FPLCharacterSnapshot::Restore(APLCharacter &Character) const
+{
+	if (UAbilitySystemComponent *AbilitySystemComponent{Character.GetAbilitySystemComponent()}; AbilitySystemComponent)
+	{
+		if (AttributeBaseValues.Num() == GetAttributeLayout().Num())
+		{
+			for (int32 AttributeIndex = 0; AttributeIndex < AttributeBaseValues.Num(); ++AttributeIndex)
+			{
+				AbilitySystemComponent->SetNumericAttributeBase(GetAttributeLayout()[AttributeIndex], AttributeBaseValues[AttributeIndex]);
+			}
+		}
+
+		// only touch the abilities, which differ from the snapshot
+		TArray<FSoftClassPath> MissingAbilityClasses{AbilityClasses};
+		TArray<FGameplayAbilitySpecHandle> SurplusAbilitySpecHandles{};
+		for (const FGameplayAbilitySpec &AbilitySpec : AbilitySystemComponent->GetActivatableAbilities())
+		{
+			if (AbilitySpec.Ability && (MissingAbilityClasses.RemoveSingleSwap(FSoftClassPath{AbilitySpec.Ability->GetClass()}) == 0))
+			{
+				SurplusAbilitySpecHandles.Add(AbilitySpec.Handle);
+			}
+		}
+		for (const FGameplayAbilitySpecHandle &SurplusAbilitySpecHandle : SurplusAbilitySpecHandles)
+		{
+			AbilitySystemComponent->ClearAbility(SurplusAbilitySpecHandle);
+		}
+		for (const FSoftClassPath &MissingAbilityClass : MissingAbilityClasses)
+		{
+			if (UClass *AbilityClass = MissingAbilityClass.TryLoadClass<UGameplayAbility>(); AbilityClass)
+			{
+				AbilitySystemComponent->GiveAbility(FGameplayAbilitySpec(AbilityClass, 1, -1, &Character));
+			}
+		}
+	}
+
+	FPLMovementSpaceTransition Transition{};
+	Transition.MovementSpace = MovementSpace;
+	Transition.MovementSpline = Cast<USplineComponent>(MovementSplinePath.ResolveObject());
+
+	// the spline of the save may not be loaded (e.g. a streamed level) or may not exist anymore, so the character must not be constrained to a missing spline
+	if ((Transition.MovementSpace == EPLMovementSpaceState::MovementOnSpline) && !Transition.MovementSpline)
+	{
+		UE_LOG(LogPLCharacterSnapshot, Warning, TEXT("The movement spline %s of the snapshot was not found. Restoring %s with the movement in 3D."), *MovementSplinePath.ToString(), *Character.GetName());
+		Transition.MovementSpace = EPLMovementSpaceState::MovementIn3D;
+	}
+	Character.ApplyMovementSpaceTransition(Transition);
+}
+
+bool FPLCharacterSnapshot::Serialize(FArchive &Ar)
+{
+	uint32 SerializedMagic{Magic};
+	uint16 SerializedLayoutVersion{LayoutVersion};
+	uint16 NumAttributes{static_cast<uint16>(AttributeBaseValues.Num())};
+	Ar << SerializedMagic;
+	Ar << SerializedLayoutVersion;
+	Ar << NumAttributes;
+
+	if (Ar.IsLoading())
+	{
+		// a snapshot of a character without ASC has no attribute values
+		if ((SerializedMagic != Magic) || (SerializedLayoutVersion != LayoutVersion) || ((NumAttributes != GetAttributeLayout().Num()) && (NumAttributes != 0)))
+		{
+			Ar.SetError();
+			return false;
+		}
+		AttributeBaseValues.SetNumUninitialized(NumAttributes);
+	}
+
+	for (float &AttributeBaseValue : AttributeBaseValues)
+	{
+		Ar << AttributeBaseValue;
+	}
+	Ar << AbilityClasses;
+
+	uint8 SerializedMovementSpace{static_cast<uint8>(MovementSpace)};
+	Ar << SerializedMovementSpace;
+	if (Ar.IsLoading() && (SerializedMovementSpace > static_cast<uint8>(EPLMovementSpaceState::MovementOnSpline)))
+	{
+		UE_LOG(LogPLCharacterSnapshot, Warning, TEXT("The snapshot has the unknown movement space state %u. The movement in 3D is used instead."), SerializedMovementSpace);
+		SerializedMovementSpace = static_cast<uint8>(EPLMovementSpaceState::MovementIn3D);
+	}
+	MovementSpace = static_cast<EPLMovementSpaceState>(SerializedMovementSpace);
+
+	Ar << MovementSplinePath;
+
+	return !Ar.IsError();
+}
+
+void FPLCharacterSnapshot::SaveToBuffer(TArray<uint8> &OutBuffer) const
+{
+	OutBuffer.Reset();
+	FMemoryWriter Writer{OutBuffer};
+
+	// saving does not modify the snapshot
+	const_cast<FPLCharacterSnapshot *>(this)->Serialize(Writer);
+}
+
+bool FPLCharacterSnapshot::LoadFromBuffer(const TArray<uint8> &Buffer, FPLCharacterSnapshot &OutSnapshot)
+{
+	FMemoryReader Reader{Buffer};
+	return OutSnapshot.Serialize(Reader);
+}
@@ -0,0 +1,261 @@
+// Copyright TinyAlmonds (Alex Noerdemann)
+
+#include "Core/SaveGame/PLSaveGameSubsystem.h"
+
+#include "Async/Async.h"
+#include "Misc/Compression.h"
+#include "Misc/Crc.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+#include "Core/PLCharacter.h"
+#include "Core/SaveGame/PLCharacterSnapshot.h"
+#include "Core/Subsystem/PLHitchDetectorSubsystem.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogPLSaveGame, Log, All);
+
+namespace
+{
+	/** Size of the serialized FPLSaveSlotHeader [bytes]. */
+	constexpr int32 SaveSlotHeaderSize{sizeof(uint32) + sizeof(uint16) + sizeof(uint64) + 3 * sizeof(uint32)};
+}
+
+bool UPLSaveGameSubsystem::FPLSaveSlotHeader::Serialize(FArchive &Ar)
+{
+	uint32 SerializedMagic{Magic};
+	uint16 SerializedFormatVersion{FormatVersion};
+	Ar << SerializedMagic;
+	Ar << SerializedFormatVersion;
+	Ar << SequenceNumber;
+	Ar << UncompressedSize;
+	Ar << CompressedSize;
+	Ar << PayloadCrc;
+
+	return !Ar.IsError() && (SerializedMagic == Magic) && (SerializedFormatVersion == FormatVersion);
+}
+
+void UPLSaveGameSubsystem::Initialize(FSubsystemCollectionBase &Collection)
+{
+	Super::Initialize(Collection);
+
+	for (TArray<uint8> &SnapshotBuffer : SnapshotBuffers)
+	{
+		SnapshotBuffer.Reserve(InitialBufferSize);
+	}
+	FileBuffer.Reserve(InitialBufferSize);
+
+	// continue the sequence of the latest valid save, so that the next save never overwrites it
+	for (int32 Slot = 0; Slot < NumSlots; ++Slot)
+	{
+		FPLSaveSlotHeader Header{};
+		if (ReadSlotFile(GetSlotFilePath(Slot), Header, nullptr) && (Header.SequenceNumber >= SequenceNumber))
+		{
+			SequenceNumber = Header.SequenceNumber;
+			LatestValidSlot = Slot;
+		}
+	}
+}
+
+void UPLSaveGameSubsystem::Deinitialize()
+{
+	// the completion of the running write is not received anymore, so it is drained here: the queued save then goes into the other slot and is not overwritten by the
+	// older in-flight save
+	if (WriteFuture.IsValid())
+	{
+		const bool bSuccess{WriteFuture.Get()};
+		if (IsWriteInProgress())
+		{
+			if (bSuccess)
+			{
+				LatestValidSlot = (LatestValidSlot + 1) % NumSlots;
+			}
+			InFlightSnapshotBufferIndex = INDEX_NONE;
+		}
+	}
+
+	// the queued save is the most recent one, so it is written synchronously after the drained write
+	if (QueuedSnapshotBufferIndex != INDEX_NONE)
+	{
+		const int32 Slot{(LatestValidSlot + 1) % NumSlots};
+		if (WriteSlotFile(SnapshotBuffers[QueuedSnapshotBufferIndex], FileBuffer, GetSlotFilePath(Slot), ++SequenceNumber))
+		{
+			LatestValidSlot = Slot;
+		}
+		QueuedSnapshotBufferIndex = INDEX_NONE;
+	}
+
+	Super::Deinitialize();
+}
+
+bool UPLSaveGameSubsystem::SaveCharacterAsync(APLCharacter *Character)
+{
+	PL_SCOPE_HITCH_STAGE(Save);
+
+	if (!Character)
+	{
+		return false;
+	}
+
+	// the buffer, which is not written by the background task, receives the snapshot (and replaces a queued one)
+	const int32 SnapshotBufferIndex{(InFlightSnapshotBufferIndex == 0) ? 1 : 0};
+	FPLCharacterSnapshot::Capture(*Character).SaveToBuffer(SnapshotBuffers[SnapshotBufferIndex]);
+
+	if (IsWriteInProgress())
+	{
+		QueuedSnapshotBufferIndex = SnapshotBufferIndex;
+	}
+	else
+	{
+		StartWrite(SnapshotBufferIndex);
+	}
+
+	return true;
+}
+
+bool UPLSaveGameSubsystem::RestoreCharacter(APLCharacter *Character) const
+{
+	PL_SCOPE_HITCH_STAGE(Save);
+
+	FPLCharacterSnapshot Snapshot{};
+	if (Character && LoadLatestCharacterSnapshot(Snapshot))
+	{
+		Snapshot.Restore(*Character);
+		return true;
+	}
+
+	return false;
+}
+
+bool UPLSaveGameSubsystem::LoadLatestCharacterSnapshot(FPLCharacterSnapshot &OutSnapshot) const
+{
+	// read the headers first and try the slots from the newest to the oldest save
+	TArray<TPair<uint64, int32>, TInlineAllocator<NumSlots>> ValidSlots{};
+	for (int32 Slot = 0; Slot < NumSlots; ++Slot)
+	{
+		FPLSaveSlotHeader Header{};
+		if (ReadSlotFile(GetSlotFilePath(Slot), Header, nullptr))
+		{
+			ValidSlots.Emplace(Header.SequenceNumber, Slot);
+		}
+	}
+	ValidSlots.Sort([](const TPair<uint64, int32> &Lhs, const TPair<uint64, int32> &Rhs)
+					{ return Lhs.Key > Rhs.Key; });
+
+	for (const TPair<uint64, int32> &ValidSlot : ValidSlots)
+	{
+		FPLSaveSlotHeader Header{};
+		TArray<uint8> SnapshotBuffer{};
+		if (ReadSlotFile(GetSlotFilePath(ValidSlot.Value), Header, &SnapshotBuffer) && FPLCharacterSnapshot::LoadFromBuffer(SnapshotBuffer, OutSnapshot))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool UPLSaveGameSubsystem::IsWriteInProgress() const
+{
+	return InFlightSnapshotBufferIndex != INDEX_NONE;
+}
+
+void UPLSaveGameSubsystem::StartWrite(int32 SnapshotBufferIndex)
+{
+	const int32 Slot{(LatestValidSlot + 1) % NumSlots};
+	const uint64 WriteSequenceNumber{++SequenceNumber};
+	InFlightSnapshotBufferIndex = SnapshotBufferIndex;
+
+	// the buffers are members, which are not touched by the game thread until the write finished
+	WriteFuture = Async(EAsyncExecution::ThreadPool, [WeakThis = TWeakObjectPtr<UPLSaveGameSubsystem>{this}, SnapshotBuffer = &SnapshotBuffers[SnapshotBufferIndex], TaskFileBuffer = &FileBuffer, SlotFilePath = GetSlotFilePath(Slot), Slot, WriteSequenceNumber]()
+						{
+							const bool bSuccess{WriteSlotFile(*SnapshotBuffer, *TaskFileBuffer, SlotFilePath, WriteSequenceNumber)};
+							AsyncTask(ENamedThreads::GameThread, [WeakThis, bSuccess, Slot, WriteSequenceNumber]()
+									  {
+										  if (UPLSaveGameSubsystem *SaveGameSubsystem = WeakThis.Get(); SaveGameSubsystem)
+										  {
+											  SaveGameSubsystem->OnWriteFinished(bSuccess, Slot, WriteSequenceNumber);
+										  } });
+							return bSuccess; });
+}
+
+void UPLSaveGameSubsystem::OnWriteFinished(bool bSuccess, int32 Slot, uint64 WriteSequenceNumber)
+{
+	// the write was already drained on the deinitialization
+	if (!IsWriteInProgress())
+	{
+		return;
+	}
+
+	InFlightSnapshotBufferIndex = INDEX_NONE;
+	if (bSuccess)
+	{
+		LatestValidSlot = Slot;
+	}
+	else
+	{
+		UE_LOG(LogPLSaveGame, Error, TEXT("Writing the save %llu into %s failed. The previous save is kept."), WriteSequenceNumber, *GetSlotFilePath(Slot));
+	}
+
+	OnSaveGameWritten.Broadcast(bSuccess, static_cast<int64>(WriteSequenceNumber));
+
+	if (QueuedSnapshotBufferIndex != INDEX_NONE)
+	{
+		const int32 SnapshotBufferIndex{QueuedSnapshotBufferIndex};
+		QueuedSnapshotBufferIndex = INDEX_NONE;
+		StartWrite(SnapshotBufferIndex);
+	}
+}
+
+bool UPLSaveGameSubsystem::WriteSlotFile(const TArray<uint8> &SnapshotBuffer, TArray<uint8> &OutFileBuffer, const FString &SlotFilePath, uint64 SaveSequenceNumber)
+{
+	// compress the payload directly behind the space of the header
+	int32 CompressedSize{FCompression::CompressMemoryBound(NAME_Zlib, SnapshotBuffer.Num())};
+	OutFileBuffer.SetNumUninitialized(SaveSlotHeaderSize + CompressedSize, false);
+	if (!FCompression::CompressMemory(NAME_Zlib, OutFileBuffer.GetData() + SaveSlotHeaderSize, CompressedSize, SnapshotBuffer.GetData(), SnapshotBuffer.Num()))
+	{
+		return false;
+	}
+	OutFileBuffer.SetNumUninitialized(SaveSlotHeaderSize + CompressedSize, false);
+
+	FPLSaveSlotHeader Header{};
+	Header.SequenceNumber = SaveSequenceNumber;
+	Header.UncompressedSize = static_cast<uint32>(SnapshotBuffer.Num());
+	Header.CompressedSize = static_cast<uint32>(CompressedSize);
+	Header.PayloadCrc = FCrc::MemCrc32(OutFileBuffer.GetData() + SaveSlotHeaderSize, CompressedSize);
+	FMemoryWriter HeaderWriter{OutFileBuffer};
+	Header.Serialize(HeaderWriter);
+
+	return FFileHelper::SaveArrayToFile(OutFileBuffer, *SlotFilePath);
+}
+
+bool UPLSaveGameSubsystem::ReadSlotFile(const FString &SlotFilePath, FPLSaveSlotHeader &OutHeader, TArray<uint8> *OutSnapshotBuffer)
+{
+	TArray<uint8> FileContent{};
+	if (!FFileHelper::LoadFileToArray(FileContent, *SlotFilePath, FILEREAD_Silent) || (FileContent.Num() < SaveSlotHeaderSize))
+	{
+		return false;
+	}
+
+	// a write, which was interrupted, results in a size or checksum mismatch
+	FMemoryReader HeaderReader{FileContent};
+	if (!OutHeader.Serialize(HeaderReader) || (OutHeader.CompressedSize != static_cast<uint32>(FileContent.Num() - SaveSlotHeaderSize)) ||
+		(OutHeader.PayloadCrc != FCrc::MemCrc32(FileContent.GetData() + SaveSlotHeaderSize, OutHeader.CompressedSize)))
+	{
+		return false;
+	}
+
+	if (OutSnapshotBuffer)
+	{
+		OutSnapshotBuffer->SetNumUninitialized(OutHeader.UncompressedSize);
+		return FCompression::UncompressMemory(NAME_Zlib, OutSnapshotBuffer->GetData(), OutHeader.UncompressedSize, FileContent.GetData() + SaveSlotHeaderSize, OutHeader.CompressedSize);
+	}
+
+	return true;
+}
+
+FString UPLSaveGameSubsystem::GetSlotFilePath(int32 Slot)
+{
+	return FPaths::ProjectSavedDir() / TEXT("SaveGames") / FString::Printf(TEXT("PLCheckpoint_%c.sav"), TEXT('A') + Slot);
+}
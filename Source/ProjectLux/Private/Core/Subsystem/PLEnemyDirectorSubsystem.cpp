@@ -0,0 +1,143 @@
+// Copyright TinyAlmonds (Alex Noerdemann)
+
+#include "Core/Subsystem/PLEnemyDirectorSubsystem.h"
+
+#include "AIController.h"
+#include "BehaviorTree/BlackboardData.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Bool.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Float.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Object.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Vector.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+
+#include "Core/Benchmark/PLMemoryTags.h"
+#include "Core/PLEnemyCharacterBase.h"
+#include "Core/Subsystem/PLHitchDetectorSubsystem.h"
+
+const FName UPLEnemyDirectorSubsystem::PlayerKeyName{TEXT("Player")};
+const FName UPLEnemyDirectorSubsystem::PlayerLocationKeyName{TEXT("PlayerLocation")};
+const FName UPLEnemyDirectorSubsystem::PlayerVelocityKeyName{TEXT("PlayerVelocity")};
+const FName UPLEnemyDirectorSubsystem::DistanceToPlayerKeyName{TEXT("DistanceToPlayer")};
+const FName UPLEnemyDirectorSubsystem::HasLineOfSightToPlayerKeyName{TEXT("HasLineOfSightToPlayer")};
+
+void UPLEnemyDirectorSubsystem::RegisterEnemy(APLEnemyCharacterBase *Enemy)
+{
+	if (!Enemy || DirectedEnemies.ContainsByPredicate([Enemy](const FPLDirectedEnemy &DirectedEnemy)
+													  { return DirectedEnemy.Enemy == Enemy; }))
+	{
+		return;
+	}
+
+	LLM_SCOPE_BYTAG(ProjectLux_Caches);
+	FPLDirectedEnemy DirectedEnemy{};
+	DirectedEnemy.Enemy = Enemy;
+	DirectedEnemies.Add(DirectedEnemy);
+}
+
+void UPLEnemyDirectorSubsystem::UnregisterEnemy(APLEnemyCharacterBase *Enemy)
+{
+	DirectedEnemies.RemoveAllSwap([Enemy](const FPLDirectedEnemy &DirectedEnemy)
+								  { return DirectedEnemy.Enemy == Enemy; });
+}
+
+int32 UPLEnemyDirectorSubsystem::GetNumEnemies() const
+{
+	return DirectedEnemies.Num();
+}
+
+SIZE_T UPLEnemyDirectorSubsystem::GetAllocatedSize() const
+{
+	return DirectedEnemies.GetAllocatedSize();
+}
+
+void UPLEnemyDirectorSubsystem::Tick(float DeltaTime)
+{
+	PL_SCOPE_HITCH_STAGE(EnemyDirector);
+
+	Super::Tick(DeltaTime);
+
+	const APlayerController *PlayerController = GetWorld()->GetFirstPlayerController();
+	APawn *Player = PlayerController ? PlayerController->GetPawn() : nullptr;
+
+	// the player state is computed once for all enemies
+	const FVector PlayerLocation{Player ? Player->GetActorLocation() : FVector::ZeroVector};
+	const FVector PlayerVelocity{Player ? Player->GetVelocity() : FVector::ZeroVector};
+
+	for (int32 EnemyIndex = DirectedEnemies.Num() - 1; EnemyIndex >= 0; --EnemyIndex)
+	{
+		FPLDirectedEnemy &DirectedEnemy = DirectedEnemies[EnemyIndex];
+		const APLEnemyCharacterBase *Enemy = DirectedEnemy.Enemy.Get();
+		if (!Enemy)
+		{
+			DirectedEnemies.RemoveAtSwap(EnemyIndex, 1, false);
+			continue;
+		}
+
+		const AAIController *AIController = Cast<AAIController>(Enemy->GetController());
+		UBlackboardComponent *BlackboardComponent = AIController ? AIController->GetBlackboardComponent() : nullptr;
+		if (!BlackboardComponent || !BlackboardComponent->GetBlackboardAsset())
+		{
+			continue;
+		}
+
+		ResolveBlackboardKeys(DirectedEnemy, *BlackboardComponent);
+
+		BlackboardComponent->SetValue<UBlackboardKeyType_Object>(DirectedEnemy.PlayerKey, Player);
+		if (!Player)
+		{
+			BlackboardComponent->SetValue<UBlackboardKeyType_Bool>(DirectedEnemy.HasLineOfSightToPlayerKey, false);
+			continue;
+		}
+
+		BlackboardComponent->SetValue<UBlackboardKeyType_Vector>(DirectedEnemy.PlayerLocationKey, PlayerLocation);
+		BlackboardComponent->SetValue<UBlackboardKeyType_Vector>(DirectedEnemy.PlayerVelocityKey, PlayerVelocity);
+		BlackboardComponent->SetValue<UBlackboardKeyType_Float>(DirectedEnemy.DistanceToPlayerKey, static_cast<float>(FVector::Dist(Enemy->GetActorLocation(), PlayerLocation)));
+
+		// the trace is only needed, if a behavior tree uses the result
+		if (DirectedEnemy.HasLineOfSightToPlayerKey != FBlackboard::InvalidKey)
+		{
+			BlackboardComponent->SetValue<UBlackboardKeyType_Bool>(DirectedEnemy.HasLineOfSightToPlayerKey, HasLineOfSight(*Enemy, *Player));
+		}
+	}
+}
+
+TStatId UPLEnemyDirectorSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UPLEnemyDirectorSubsystem, STATGROUP_Tickables);
+}
+
+bool UPLEnemyDirectorSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return (WorldType == EWorldType::Game) || (WorldType == EWorldType::PIE);
+}
+
+void UPLEnemyDirectorSubsystem::ResolveBlackboardKeys(FPLDirectedEnemy &DirectedEnemy, const UBlackboardComponent &BlackboardComponent)
+{
+	const UBlackboardData *BlackboardAsset = BlackboardComponent.GetBlackboardAsset();
+	if (DirectedEnemy.BlackboardAsset == BlackboardAsset)
+	{
+		return;
+	}
+
+	// the key ids avoid the lookup by name on every frame
+	DirectedEnemy.BlackboardAsset = BlackboardAsset;
+	DirectedEnemy.PlayerKey = BlackboardComponent.GetKeyID(PlayerKeyName);
+	DirectedEnemy.PlayerLocationKey = BlackboardComponent.GetKeyID(PlayerLocationKeyName);
+	DirectedEnemy.PlayerVelocityKey = BlackboardComponent.GetKeyID(PlayerVelocityKeyName);
+	DirectedEnemy.DistanceToPlayerKey = BlackboardComponent.GetKeyID(DistanceToPlayerKeyName);
+	DirectedEnemy.HasLineOfSightToPlayerKey = BlackboardComponent.GetKeyID(HasLineOfSightToPlayerKeyName);
+}
+
+bool UPLEnemyDirectorSubsystem::HasLineOfSight(const APLEnemyCharacterBase &Enemy, const APawn &Player) const
+{
+	FVector EyesLocation{};
+	FRotator EyesRotation{};
+	Enemy.GetActorEyesViewPoint(EyesLocation, EyesRotation);
+
+	FCollisionQueryParams QueryParams{SCENE_QUERY_STAT(PLEnemyDirectorLineOfSight), false, &Enemy};
+	QueryParams.AddIgnoredActor(&Player);
+
+	return !GetWorld()->LineTraceTestByChannel(EyesLocation, Player.GetActorLocation(), ECC_Visibility, QueryParams);
+}
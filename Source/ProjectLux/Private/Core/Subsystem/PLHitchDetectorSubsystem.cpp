@@ -0,0 +1,243 @@
+// Copyright TinyAlmonds (Alex Noerdemann)
+
+#include "Core/Subsystem/PLHitchDetectorSubsystem.h"
+
+#include "Async/Async.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/Compression.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+#include "Core/Benchmark/PLMemoryTags.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogPLHitchDetector, Log, All);
+
+namespace
+{
+	TAutoConsoleVariable<bool> CVarPLHitchEnabled{TEXT("projectlux.Hitch.Enabled"), static_cast<bool>(PL_WITH_HITCH_DETECTOR), TEXT("Whether the stage times of the last frames are recorded and dumped on hitches.")};
+	TAutoConsoleVariable<float> CVarPLHitchBudget{TEXT("projectlux.Hitch.Budget"), 50.0f, TEXT("Frame time above which the recorded frames are dumped [ms].")};
+
+	/** Number of stages. */
+	constexpr int32 NumStages{static_cast<int32>(EPLHitchStage::Num)};
+
+	/** Extension of the dump files. */
+	const TCHAR *DumpFileExtension{TEXT(".plhitch")};
+
+	/** Upper bound of the uncompressed dump: The header (magic, format version, number of stages, frame budget, number of frames) and a full buffer of frames [bytes]. */
+	constexpr int32 MaxDumpPayloadSize{static_cast<int32>(sizeof(uint32) + sizeof(uint16) + sizeof(uint8) + sizeof(float) + sizeof(int32) +
+														  UPLHitchDetectorSubsystem::NumRecordedFrames * sizeof(FPLHitchFrame))};
+}
+
+std::atomic<uint64> UPLHitchDetectorSubsystem::StageCycles[NumStages]{};
+std::atomic<uint32> UPLHitchDetectorSubsystem::StageCounts[NumStages]{};
+std::atomic<bool> UPLHitchDetectorSubsystem::bRecording{false};
+
+bool FPLHitchDump::Serialize(FArchive &Ar)
+{
+	uint32 SerializedMagic{Magic};
+	uint16 SerializedFormatVersion{FormatVersion};
+	uint8 SerializedNumStages{static_cast<uint8>(NumStages)};
+	int32 NumFrames{Frames.Num()};
+	Ar << SerializedMagic;
+	Ar << SerializedFormatVersion;
+	Ar << SerializedNumStages;
+	Ar << FrameBudget;
+	Ar << NumFrames;
+
+	if (Ar.IsLoading())
+	{
+		if (Ar.IsError() || (SerializedMagic != Magic) || (SerializedFormatVersion != FormatVersion) || (SerializedNumStages != NumStages) ||
+			(NumFrames < 0) || (NumFrames > UPLHitchDetectorSubsystem::NumRecordedFrames))
+		{
+			return false;
+		}
+		Frames.SetNum(NumFrames);
+	}
+
+	for (FPLHitchFrame &Frame : Frames)
+	{
+		Ar << Frame.FrameNumber;
+		Ar << Frame.FrameTime;
+		for (int32 StageIndex = 0; StageIndex < NumStages; ++StageIndex)
+		{
+			Ar << Frame.StageTimes[StageIndex];
+			Ar << Frame.StageCounts[StageIndex];
+		}
+	}
+
+	return !Ar.IsError();
+}
+
+void UPLHitchDetectorSubsystem::Initialize(FSubsystemCollectionBase &Collection)
+{
+	Super::Initialize(Collection);
+
+#if PL_WITH_HITCH_DETECTOR
+	LLM_SCOPE_BYTAG(ProjectLux_Caches);
+	RecordedFrames.SetNum(NumRecordedFrames);
+	EndFrameHandle = FCoreDelegates::OnEndFrame.AddUObject(this, &UPLHitchDetectorSubsystem::OnEndFrame);
+#endif
+}
+
+void UPLHitchDetectorSubsystem::Deinitialize()
+{
+	FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+	bRecording.store(false, std::memory_order_relaxed);
+	if (WriteFuture.IsValid())
+	{
+		WriteFuture.Wait();
+	}
+
+	Super::Deinitialize();
+}
+
+void UPLHitchDetectorSubsystem::AddStageTime(EPLHitchStage Stage, uint64 Cycles)
+{
+	const int32 StageIndex{static_cast<int32>(Stage)};
+	StageCycles[StageIndex].fetch_add(Cycles, std::memory_order_relaxed);
+	StageCounts[StageIndex].fetch_add(1, std::memory_order_relaxed);
+}
+
+bool UPLHitchDetectorSubsystem::IsRecording()
+{
+	return bRecording.load(std::memory_order_relaxed);
+}
+
+FString UPLHitchDetectorSubsystem::GetDumpDirectory()
+{
+	return FPaths::ProfilingDir() / TEXT("Hitches");
+}
+
+FString UPLHitchDetectorSubsystem::FindLatestDumpFile()
+{
+	TArray<FString> DumpFileNames{};
+	IFileManager::Get().FindFiles(DumpFileNames, *(GetDumpDirectory() / FString{TEXT("*")} + DumpFileExtension), true, false);
+	if (DumpFileNames.IsEmpty())
+	{
+		return FString{};
+	}
+
+	// the file names start with the time of the dump
+	DumpFileNames.Sort();
+	return GetDumpDirectory() / DumpFileNames.Last();
+}
+
+bool UPLHitchDetectorSubsystem::ReadDumpFile(const FString &DumpFilePath, FPLHitchDump &OutDump)
+{
+	TArray<uint8> FileContent{};
+	if (!FFileHelper::LoadFileToArray(FileContent, *DumpFilePath, FILEREAD_Silent) || (FileContent.Num() < static_cast<int32>(sizeof(int32))))
+	{
+		return false;
+	}
+
+	int32 UncompressedSize{0};
+	FMemoryReader SizeReader{FileContent};
+	SizeReader << UncompressedSize;
+	// the size is read from the file, so it is bounded before the allocation (e.g. a corrupted or foreign file)
+	if ((UncompressedSize <= 0) || (UncompressedSize > MaxDumpPayloadSize))
+	{
+		UE_LOG(LogPLHitchDetector, Warning, TEXT("Rejected the hitch dump %s with an uncompressed size of %d bytes."), *DumpFilePath, UncompressedSize);
+		return false;
+	}
+
+	TArray<uint8> Payload{};
+	Payload.SetNumUninitialized(UncompressedSize);
+	if (!FCompression::UncompressMemory(NAME_Zlib, Payload.GetData(), UncompressedSize, FileContent.GetData() + sizeof(int32), FileContent.Num() - sizeof(int32)))
+	{
+		return false;
+	}
+
+	FMemoryReader PayloadReader{Payload};
+	return OutDump.Serialize(PayloadReader);
+}
+
+SIZE_T UPLHitchDetectorSubsystem::GetAllocatedSize() const
+{
+	return RecordedFrames.GetAllocatedSize();
+}
+
+void UPLHitchDetectorSubsystem::OnEndFrame()
+{
+	const bool bEnabled{CVarPLHitchEnabled.GetValueOnGameThread()};
+	const bool bWasRecording{bRecording.exchange(bEnabled, std::memory_order_relaxed)};
+	const uint64 EndFrameCycles{FPlatformTime::Cycles64()};
+	const uint64 FrameCycles{EndFrameCycles - PreviousEndFrameCycles};
+	PreviousEndFrameCycles = EndFrameCycles;
+
+	// the first frame of a recording has no valid frame time and partial stage times
+	if (!bEnabled || !bWasRecording)
+	{
+		for (int32 StageIndex = 0; StageIndex < NumStages; ++StageIndex)
+		{
+			StageCycles[StageIndex].store(0, std::memory_order_relaxed);
+			StageCounts[StageIndex].store(0, std::memory_order_relaxed);
+		}
+		NumFramesSinceDump = 0;
+		return;
+	}
+
+	FPLHitchFrame &Frame = RecordedFrames[NextFrameSlot];
+	Frame.FrameNumber = GFrameCounter;
+	Frame.FrameTime = static_cast<float>(FPlatformTime::ToMilliseconds64(FrameCycles));
+	for (int32 StageIndex = 0; StageIndex < NumStages; ++StageIndex)
+	{
+		Frame.StageTimes[StageIndex] = static_cast<float>(FPlatformTime::ToMilliseconds64(StageCycles[StageIndex].exchange(0, std::memory_order_relaxed)));
+		Frame.StageCounts[StageIndex] = static_cast<uint16>(FMath::Min(StageCounts[StageIndex].exchange(0, std::memory_order_relaxed), static_cast<uint32>(TNumericLimits<uint16>::Max())));
+	}
+	NextFrameSlot = (NextFrameSlot + 1) % NumRecordedFrames;
+	++NumFramesSinceDump;
+
+	// a full buffer of new frames is required between two dumps, so that the dumps do not overlap and a burst of hitches (e.g. a level load) does not flood the disk
+	const float FrameBudget{CVarPLHitchBudget.GetValueOnGameThread()};
+	if ((Frame.FrameTime > FrameBudget) && (NumFramesSinceDump >= NumRecordedFrames) && !(WriteFuture.IsValid() && !WriteFuture.IsReady()))
+	{
+		WriteDump(FrameBudget);
+		NumFramesSinceDump = 0;
+	}
+}
+
+void UPLHitchDetectorSubsystem::WriteDump(float FrameBudget)
+{
+	// the oldest frame is in the slot receiving the next frame
+	FPLHitchDump Dump{};
+	Dump.FrameBudget = FrameBudget;
+	Dump.Frames.Reserve(NumRecordedFrames);
+	for (int32 FrameIndex = 0; FrameIndex < NumRecordedFrames; ++FrameIndex)
+	{
+		Dump.Frames.Add(RecordedFrames[(NextFrameSlot + FrameIndex) % NumRecordedFrames]);
+	}
+
+	TArray<uint8> Payload{};
+	FMemoryWriter PayloadWriter{Payload};
+	Dump.Serialize(PayloadWriter);
+
+	const FString DumpFilePath{GetDumpDirectory() / FString::Printf(TEXT("Hitch_%s_%llu%s"), *FDateTime::Now().ToString(), Dump.Frames.Last().FrameNumber, DumpFileExtension)};
+	UE_LOG(LogPLHitchDetector, Warning, TEXT("Frame %llu took %.2f ms (budget %.2f ms). Dumping the last %d frames into %s."), Dump.Frames.Last().FrameNumber, Dump.Frames.Last().FrameTime, FrameBudget, NumRecordedFrames, *DumpFilePath);
+
+	// the compression and the file write would extend the hitch, so they run on a background task
+	WriteFuture = Async(EAsyncExecution::ThreadPool, [Payload = MoveTemp(Payload), DumpFilePath]()
+						{
+							int32 CompressedSize{FCompression::CompressMemoryBound(NAME_Zlib, Payload.Num())};
+							TArray<uint8> FileContent{};
+							FileContent.SetNumUninitialized(sizeof(int32) + CompressedSize);
+							if (!FCompression::CompressMemory(NAME_Zlib, FileContent.GetData() + sizeof(int32), CompressedSize, Payload.GetData(), Payload.Num()))
+							{
+								UE_LOG(LogPLHitchDetector, Error, TEXT("Compressing the hitch dump %s failed."), *DumpFilePath);
+								return;
+							}
+							FileContent.SetNum(sizeof(int32) + CompressedSize);
+
+							int32 UncompressedSize{Payload.Num()};
+							FMemoryWriter SizeWriter{FileContent};
+							SizeWriter << UncompressedSize;
+
+							if (!FFileHelper::SaveArrayToFile(FileContent, *DumpFilePath))
+							{
+								UE_LOG(LogPLHitchDetector, Error, TEXT("Writing the hitch dump %s failed."), *DumpFilePath);
+							} });
+}
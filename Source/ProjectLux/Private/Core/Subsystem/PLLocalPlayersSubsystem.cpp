@@ -0,0 +1,127 @@
+// Copyright TinyAlmonds (Alex Noerdemann)
+
+#include "Core/Subsystem/PLLocalPlayersSubsystem.h"
+
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+
+#include "Core/Benchmark/PLMemoryTags.h"
+
+int32 UPLLocalPlayersSubsystem::GetNumLocalPlayerPawns() const
+{
+	return LocalPlayerPawns.Num();
+}
+
+APawn *UPLLocalPlayersSubsystem::FindNearestPlayerPawn(const FVector &Location) const
+{
+	const int32 NearestPlayerIndex{FindNearestPlayerIndex(Location, nullptr)};
+	return (NearestPlayerIndex != INDEX_NONE) ? LocalPlayerPawns[NearestPlayerIndex].Pawn.Get() : nullptr;
+}
+
+APawn *UPLLocalPlayersSubsystem::GetNearestPlayerPawn(const AActor *Querier)
+{
+	if (!Querier)
+	{
+		return nullptr;
+	}
+
+	// the first query is answered immediately, all further queries by the batch of the tick
+	if (FPLNearestPlayerQuery *NearestPlayerQuery = NearestPlayerQueries.Find(Querier); NearestPlayerQuery)
+	{
+		NearestPlayerQuery->bQueried = true;
+		return NearestPlayerQuery->NearestPlayer.Get();
+	}
+
+	if (LocalPlayerPawns.IsEmpty())
+	{
+		CacheLocalPlayerPawns();
+	}
+
+	LLM_SCOPE_BYTAG(ProjectLux_Caches);
+	FPLNearestPlayerQuery &NearestPlayerQuery = NearestPlayerQueries.Add(Querier);
+	NearestPlayerQuery.NearestPlayer = FindNearestPlayerPawn(Querier->GetActorLocation());
+	return NearestPlayerQuery.NearestPlayer.Get();
+}
+
+SIZE_T UPLLocalPlayersSubsystem::GetAllocatedSize() const
+{
+	return LocalPlayerPawns.GetAllocatedSize() + NearestPlayerQueries.GetAllocatedSize();
+}
+
+void UPLLocalPlayersSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	CacheLocalPlayerPawns();
+
+	for (auto QueryIt = NearestPlayerQueries.CreateIterator(); QueryIt; ++QueryIt)
+	{
+		// queriers, which were destroyed or did not ask in the last frame, are removed from the batch
+		const AActor *Querier = QueryIt.Key().ResolveObjectPtr();
+		FPLNearestPlayerQuery &NearestPlayerQuery = QueryIt.Value();
+		if (!Querier || !NearestPlayerQuery.bQueried)
+		{
+			QueryIt.RemoveCurrent();
+			continue;
+		}
+
+		const int32 NearestPlayerIndex{FindNearestPlayerIndex(Querier->GetActorLocation(), NearestPlayerQuery.NearestPlayer.Get())};
+		NearestPlayerQuery.NearestPlayer = (NearestPlayerIndex != INDEX_NONE) ? LocalPlayerPawns[NearestPlayerIndex].Pawn : nullptr;
+		NearestPlayerQuery.bQueried = false;
+	}
+}
+
+TStatId UPLLocalPlayersSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UPLLocalPlayersSubsystem, STATGROUP_Tickables);
+}
+
+bool UPLLocalPlayersSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return (WorldType == EWorldType::Game) || (WorldType == EWorldType::PIE);
+}
+
+void UPLLocalPlayersSubsystem::CacheLocalPlayerPawns()
+{
+	LocalPlayerPawns.Reset();
+	for (FConstPlayerControllerIterator PlayerControllerIt = GetWorld()->GetPlayerControllerIterator(); PlayerControllerIt; ++PlayerControllerIt)
+	{
+		const APlayerController *PlayerController = PlayerControllerIt->Get();
+		if (PlayerController && PlayerController->IsLocalController())
+		{
+			if (APawn *Pawn = PlayerController->GetPawn(); Pawn)
+			{
+				LocalPlayerPawns.Add(FPLLocalPlayerPawn{Pawn, Pawn->GetActorLocation()});
+			}
+		}
+	}
+}
+
+int32 UPLLocalPlayersSubsystem::FindNearestPlayerIndex(const FVector &Location, const APawn *CurrentNearestPlayer) const
+{
+	// the few local players are searched linearly on the cached locations, so no pawn is touched
+	int32 NearestPlayerIndex{INDEX_NONE};
+	double NearestDistance{TNumericLimits<double>::Max()};
+	for (int32 PlayerIndex = 0; PlayerIndex < LocalPlayerPawns.Num(); ++PlayerIndex)
+	{
+		const FPLLocalPlayerPawn &LocalPlayerPawn = LocalPlayerPawns[PlayerIndex];
+		if (!LocalPlayerPawn.Pawn.IsValid())
+		{
+			continue;
+		}
+
+		double Distance{FVector::Dist(Location, LocalPlayerPawn.Location)};
+		if (LocalPlayerPawn.Pawn == CurrentNearestPlayer)
+		{
+			Distance -= NearestPlayerSwitchDistance;
+		}
+		if (Distance < NearestDistance)
+		{
+			NearestDistance = Distance;
+			NearestPlayerIndex = PlayerIndex;
+		}
+	}
+
+	return NearestPlayerIndex;
+}
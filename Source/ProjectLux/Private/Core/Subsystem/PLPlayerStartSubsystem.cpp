@@ -0,0 +1,77 @@
+// Copyright TinyAlmonds (Alex Noerdemann)
+
+#include "Core/Subsystem/PLPlayerStartSubsystem.h"
+
+#include "GameFramework/Controller.h"
+
+#include "Core/PLCharacter.h"
+#include "Core/PLPlayerStart.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogPLPlayerStartSubsystem, Log, All);
+
+void UPLPlayerStartSubsystem::RegisterPlayerStart(APLPlayerStart *PlayerStart)
+{
+	if (!PlayerStart || PlayerStart->PlayerStartTag.IsNone())
+	{
+		return;
+	}
+
+	if (const FPLPlayerStartEntry *RegisteredEntry{PlayerStarts.Find(PlayerStart->PlayerStartTag)}; RegisteredEntry && RegisteredEntry->PlayerStart && (RegisteredEntry->PlayerStart != PlayerStart))
+	{
+		UE_LOG(LogPLPlayerStartSubsystem, Warning, TEXT("PlayerStart %s uses the tag %s of PlayerStart %s. Only the first one is registered."),
+			   *PlayerStart->GetName(), *PlayerStart->PlayerStartTag.ToString(), *RegisteredEntry->PlayerStart->GetName());
+		return;
+	}
+
+	FPLPlayerStartEntry Entry{};
+	Entry.PlayerStart = PlayerStart;
+	Entry.SpawnTransition = PlayerStart->GetSpawnMovementSpaceTransition();
+	PlayerStarts.Add(PlayerStart->PlayerStartTag, Entry);
+}
+
+void UPLPlayerStartSubsystem::UnregisterPlayerStart(APLPlayerStart *PlayerStart)
+{
+	if (!PlayerStart)
+	{
+		return;
+	}
+
+	if (const FPLPlayerStartEntry *RegisteredEntry{PlayerStarts.Find(PlayerStart->PlayerStartTag)}; RegisteredEntry && (RegisteredEntry->PlayerStart == PlayerStart))
+	{
+		PlayerStarts.Remove(PlayerStart->PlayerStartTag);
+	}
+}
+
+APLPlayerStart *UPLPlayerStartSubsystem::FindPlayerStart(FName PlayerStartTag) const
+{
+	const FPLPlayerStartEntry *Entry{FindPlayerStartEntry(PlayerStartTag)};
+	return Entry ? Entry->PlayerStart : nullptr;
+}
+
+const FPLPlayerStartEntry *UPLPlayerStartSubsystem::FindPlayerStartEntry(FName PlayerStartTag) const
+{
+	return PlayerStarts.Find(PlayerStartTag);
+}
+
+bool UPLPlayerStartSubsystem::TeleportToPlayerStart(AController *Player, FName PlayerStartTag) const
+{
+	const FPLPlayerStartEntry *Entry{FindPlayerStartEntry(PlayerStartTag)};
+	APawn *Pawn = Player ? Player->GetPawn() : nullptr;
+	if (!Entry || !Entry->PlayerStart || !Pawn)
+	{
+		return false;
+	}
+
+	const FTransform SpawnTransform{Entry->PlayerStart->GetActorRotation(), Entry->PlayerStart->GetActorLocation()};
+	if (APLCharacter *Character = Cast<APLCharacter>(Pawn); Character)
+	{
+		Character->TeleportToSpawn(SpawnTransform, Entry->SpawnTransition);
+	}
+	else
+	{
+		Pawn->TeleportTo(SpawnTransform.GetLocation(), SpawnTransform.Rotator(), false, true);
+		Player->SetControlRotation(SpawnTransform.Rotator());
+	}
+
+	return true;
+}
@@ -0,0 +1,70 @@
+// Copyright TinyAlmonds (Alex Noerdemann)
+
+#include "Core/Subsystem/PLSplineLookupSubsystem.h"
+
+#include "Components/SplineComponent.h"
+#include "Engine/World.h"
+
+#include "Core/Benchmark/PLMemoryTags.h"
+#include "Core/Types/PLSplineLookupTable.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogPLSplineLookup, Log, All);
+
+namespace
+{
+	TAutoConsoleVariable<bool> CVarPLSplineLookupTables{TEXT("projectlux.FastPath.SplineLookupTables"), true, TEXT("Whether the baked spline lookup tables are used. The splines are queried directly, if disabled."), ECVF_Cheat};
+}
+
+void UPLSplineLookupSubsystem::RegisterLookupTable(const USplineComponent *Spline, const FPLSplineLookupTable &LookupTable)
+{
+	if (!Spline || LookupTables.Contains(Spline))
+	{
+		return;
+	}
+
+	if (!LookupTable.IsValidFor(*Spline))
+	{
+		UE_LOG(LogPLSplineLookup, Warning, TEXT("The lookup table of %s is not baked or outdated. Resave the level to bake it; the spline is queried directly until then."), *Spline->GetReadableName());
+		return;
+	}
+
+	LLM_SCOPE_BYTAG(ProjectLux_Caches);
+	LookupTables.Add(Spline, &LookupTable);
+}
+
+void UPLSplineLookupSubsystem::UnregisterLookupTable(const USplineComponent *Spline, const FPLSplineLookupTable &LookupTable)
+{
+	if (const FPLSplineLookupTable *const *RegisteredTable = LookupTables.Find(Spline); RegisteredTable && (*RegisteredTable == &LookupTable))
+	{
+		LookupTables.Remove(Spline);
+	}
+}
+
+const FPLSplineLookupTable *UPLSplineLookupSubsystem::FindLookupTable(const USplineComponent *Spline) const
+{
+	const FPLSplineLookupTable *const *LookupTable = LookupTables.Find(Spline);
+	return LookupTable ? *LookupTable : nullptr;
+}
+
+const FPLSplineLookupTable *UPLSplineLookupSubsystem::FindLookupTableOfSpline(const USplineComponent *Spline)
+{
+	const UWorld *World = Spline ? Spline->GetWorld() : nullptr;
+	const UPLSplineLookupSubsystem *SplineLookupSubsystem = World ? World->GetSubsystem<UPLSplineLookupSubsystem>() : nullptr;
+	return SplineLookupSubsystem ? SplineLookupSubsystem->FindLookupTable(Spline) : nullptr;
+}
+
+bool UPLSplineLookupSubsystem::AreLookupTablesEnabled()
+{
+	return CVarPLSplineLookupTables.GetValueOnGameThread();
+}
+
+SIZE_T UPLSplineLookupSubsystem::GetAllocatedSize() const
+{
+	SIZE_T AllocatedSize{LookupTables.GetAllocatedSize()};
+	for (const TPair<TObjectKey<USplineComponent>, const FPLSplineLookupTable *> &LookupTable : LookupTables)
+	{
+		AllocatedSize += LookupTable.Value->GetAllocatedSize();
+	}
+
+	return AllocatedSize;
+}
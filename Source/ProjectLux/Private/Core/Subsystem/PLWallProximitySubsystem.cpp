@@ -0,0 +1,222 @@
+// Copyright TinyAlmonds (Alex Noerdemann)
+
+#include "Core/Subsystem/PLWallProximitySubsystem.h"
+
+#include "Components/PrimitiveComponent.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "HAL/PlatformTime.h"
+
+#include "Core/Benchmark/PLMemoryTags.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogPLWallProximity, Log, All);
+
+namespace
+{
+	TAutoConsoleVariable<bool> CVarPLWallProximityGrid{TEXT("projectlux.FastPath.WallProximityGrid"), true, TEXT("Whether the wall proximity grid skips the wall slide traces far from walls. Every trace is done, if disabled."), ECVF_Cheat};
+}
+
+bool UPLWallProximitySubsystem::MayHitWall(const FVector &Start, const FVector &End)
+{
+	if (!bBaked || !CVarPLWallProximityGrid.GetValueOnGameThread())
+	{
+		return true;
+	}
+
+	AddPendingActors();
+
+	const FVector Extent{End - Start};
+	for (const TWeakObjectPtr<UPrimitiveComponent> &UnbakedWall : UnbakedWalls)
+	{
+		if (const UPrimitiveComponent *Component = UnbakedWall.Get(); Component && FMath::LineBoxIntersection(Component->Bounds.GetBox(), Start, End, Extent))
+		{
+			return true;
+		}
+	}
+
+	// the segment is short (e.g. 1.5 times the capsule radius), so it covers only a few cells
+	const FIntVector MinCell{GetCell(Start.ComponentMin(End))};
+	const FIntVector MaxCell{GetCell(Start.ComponentMax(End))};
+	for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+	{
+		for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+		{
+			for (int32 Z = MinCell.Z; Z <= MaxCell.Z; ++Z)
+			{
+				const TArray<int32, TInlineAllocator<4>> *WallIndices = Cells.Find(FIntVector{X, Y, Z});
+				if (!WallIndices)
+				{
+					continue;
+				}
+
+				for (const int32 WallIndex : *WallIndices)
+				{
+					if (FMath::LineBoxIntersection(StaticWalls[WallIndex].Bounds, Start, End, Extent))
+					{
+						return true;
+					}
+				}
+			}
+		}
+	}
+
+	return false;
+}
+
+int32 UPLWallProximitySubsystem::GetNumCells() const
+{
+	return Cells.Num();
+}
+
+SIZE_T UPLWallProximitySubsystem::GetAllocatedSize() const
+{
+	SIZE_T AllocatedSize{StaticWalls.GetAllocatedSize() + Cells.GetAllocatedSize() + UnbakedWalls.GetAllocatedSize() + PendingActors.GetAllocatedSize()};
+	for (const TPair<FIntVector, TArray<int32, TInlineAllocator<4>>> &Cell : Cells)
+	{
+		AllocatedSize += Cell.Value.GetAllocatedSize();
+	}
+
+	return AllocatedSize;
+}
+
+void UPLWallProximitySubsystem::OnWorldBeginPlay(UWorld &InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	Bake(InWorld);
+
+	ActorSpawnedHandle = InWorld.AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateUObject(this, &UPLWallProximitySubsystem::OnActorSpawned));
+	LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddUObject(this, &UPLWallProximitySubsystem::OnLevelAddedToWorld);
+	LevelRemovedHandle = FWorldDelegates::LevelRemovedFromWorld.AddUObject(this, &UPLWallProximitySubsystem::OnLevelRemovedFromWorld);
+}
+
+void UPLWallProximitySubsystem::Deinitialize()
+{
+	if (UWorld *World = GetWorld(); World)
+	{
+		World->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+	}
+	FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+	FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedHandle);
+
+	Super::Deinitialize();
+}
+
+bool UPLWallProximitySubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return (WorldType == EWorldType::Game) || (WorldType == EWorldType::PIE);
+}
+
+void UPLWallProximitySubsystem::AddWallsOfActor(const AActor &Actor)
+{
+	LLM_SCOPE_BYTAG(ProjectLux_Caches);
+
+	TInlineComponentArray<UPrimitiveComponent *> PrimitiveComponents{&Actor};
+	for (UPrimitiveComponent *Component : PrimitiveComponents)
+	{
+		if (!Component->IsRegistered() || !Component->IsQueryCollisionEnabled() || (Component->GetCollisionResponseToChannel(WallSlideTraceChannel) != ECR_Block))
+		{
+			continue;
+		}
+
+		const FBox Bounds{Component->Bounds.GetBox()};
+		const FIntVector MinCell{GetCell(Bounds.Min)};
+		const FIntVector MaxCell{GetCell(Bounds.Max)};
+		const int64 NumCells{static_cast<int64>(MaxCell.X - MinCell.X + 1) * (MaxCell.Y - MinCell.Y + 1) * (MaxCell.Z - MinCell.Z + 1)};
+		if ((Component->Mobility == EComponentMobility::Movable) || (NumCells > MaxCellsPerWall))
+		{
+			UnbakedWalls.Add(Component);
+			continue;
+		}
+
+		FPLWallEntry WallEntry{};
+		WallEntry.Bounds = Bounds;
+		WallEntry.Component = Component;
+		const int32 WallIndex{StaticWalls.Add(WallEntry)};
+
+		for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+		{
+			for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+			{
+				for (int32 Z = MinCell.Z; Z <= MaxCell.Z; ++Z)
+				{
+					Cells.FindOrAdd(FIntVector{X, Y, Z}).Add(WallIndex);
+				}
+			}
+		}
+	}
+}
+
+void UPLWallProximitySubsystem::Bake(UWorld &World, const ULevel *ExcludedLevel)
+{
+	const double BakeStartTime{FPlatformTime::Seconds()};
+	StaticWalls.Reset();
+	Cells.Reset();
+	UnbakedWalls.Reset();
+	PendingActors.Reset();
+	for (TActorIterator<AActor> ActorIt(&World); ActorIt; ++ActorIt)
+	{
+		if (ActorIt->GetLevel() != ExcludedLevel)
+		{
+			AddWallsOfActor(**ActorIt);
+		}
+	}
+	bBaked = true;
+
+	UE_LOG(LogPLWallProximity, Log, TEXT("Baked %d static walls into %d cells (%d unbaked walls) in %.2f ms."), StaticWalls.Num(), Cells.Num(), UnbakedWalls.Num(), (FPlatformTime::Seconds() - BakeStartTime) * 1000.0);
+}
+
+FIntVector UPLWallProximitySubsystem::GetCell(const FVector &Location)
+{
+	return FIntVector{FMath::FloorToInt32(Location.X / CellSize), FMath::FloorToInt32(Location.Y / CellSize), FMath::FloorToInt32(Location.Z / CellSize)};
+}
+
+void UPLWallProximitySubsystem::OnActorSpawned(AActor *Actor)
+{
+	// the collision responses of a spawned actor are often set up after the spawn, so the actor is added on the next query
+	LLM_SCOPE_BYTAG(ProjectLux_Caches);
+	PendingActors.Add(Actor);
+}
+
+void UPLWallProximitySubsystem::AddPendingActors()
+{
+	for (const TWeakObjectPtr<AActor> &PendingActor : PendingActors)
+	{
+		if (const AActor *Actor = PendingActor.Get(); Actor)
+		{
+			AddWallsOfActor(*Actor);
+		}
+	}
+	PendingActors.Reset();
+}
+
+void UPLWallProximitySubsystem::OnLevelAddedToWorld(ULevel *Level, UWorld *World)
+{
+	if (!bBaked || !Level || (World != GetWorld()))
+	{
+		return;
+	}
+
+	// the actors of a streamed level do not pass the spawn handler, so they are queued like spawned actors
+	LLM_SCOPE_BYTAG(ProjectLux_Caches);
+	for (AActor *Actor : Level->Actors)
+	{
+		if (Actor)
+		{
+			PendingActors.Add(Actor);
+		}
+	}
+}
+
+void UPLWallProximitySubsystem::OnLevelRemovedFromWorld(ULevel *Level, UWorld *World)
+{
+	// a null level is broadcast on the cleanup of the whole world
+	if (!bBaked || !Level || !World || (World != GetWorld()))
+	{
+		return;
+	}
+
+	// the cells only reference the walls by index, so the grid is rebaked instead of removing the walls one by one (streaming out is rare compared to the queries)
+	Bake(*World, Level);
+}
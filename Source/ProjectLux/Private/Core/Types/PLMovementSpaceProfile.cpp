@@ -0,0 +1,48 @@
+// Copyright TinyAlmonds (Alex Noerdemann)
+
+#include "Core/Types/PLMovementSpaceProfile.h"
+
+namespace
+{
+	FPLMovementSpaceProfile MakeMovementSpaceProfile(bool bPlaneConstraintEnabled, EPlaneConstraintAxisSetting PlaneConstraintAxisSetting, bool bConstrainToSpline, float CameraBlendTime,
+													 EViewTargetBlendFunction CameraBlendFunction)
+	{
+		FPLMovementSpaceProfile Profile{};
+		Profile.bPlaneConstraintEnabled = bPlaneConstraintEnabled;
+		Profile.PlaneConstraintAxisSetting = PlaneConstraintAxisSetting;
+		Profile.bConstrainToSpline = bConstrainToSpline;
+		Profile.CameraBlendTime = CameraBlendTime;
+		Profile.CameraBlendFunction = CameraBlendFunction;
+		return Profile;
+	}
+}
+
+const FPLMovementSpaceProfile &FPLMovementSpaceProfile::Get(EPLMovementSpaceState State)
+{
+	// the side views of the constrained states are blended faster than the free camera, since the controls depend on them
+	static const FPLMovementSpaceProfile MovementIn2DProfile{MakeMovementSpaceProfile(true, EPlaneConstraintAxisSetting::X, false, 0.5f, VTBlend_EaseInOut)};
+	static const FPLMovementSpaceProfile MovementIn3DProfile{MakeMovementSpaceProfile(false, EPlaneConstraintAxisSetting::Custom, false, 1.0f, VTBlend_EaseInOut)};
+	static const FPLMovementSpaceProfile MovementOnSplineProfile{MakeMovementSpaceProfile(false, EPlaneConstraintAxisSetting::Custom, true, 0.5f, VTBlend_EaseInOut)};
+
+	switch (State)
+	{
+	case EPLMovementSpaceState::MovementIn2D:
+		return MovementIn2DProfile;
+	case EPLMovementSpaceState::MovementOnSpline:
+		return MovementOnSplineProfile;
+	case EPLMovementSpaceState::MovementIn3D:
+	default:
+		return MovementIn3DProfile;
+	}
+}
+
+bool FPLMovementSpaceProfile::HasEqualPlaneConstraint(const FPLMovementSpaceProfile &Other) const
+{
+	// the axis setting is irrelevant, if both profiles do not constrain the movement to a plane
+	return (bPlaneConstraintEnabled == Other.bPlaneConstraintEnabled) && (!bPlaneConstraintEnabled || (PlaneConstraintAxisSetting == Other.PlaneConstraintAxisSetting));
+}
+
+bool FPLMovementSpaceTransition::operator==(const FPLMovementSpaceTransition &Other) const
+{
+	return (MovementSpace == Other.MovementSpace) && (MovementSpline == Other.MovementSpline) && (Camera == Other.Camera);
+}
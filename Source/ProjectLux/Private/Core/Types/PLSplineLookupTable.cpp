@@ -0,0 +1,243 @@
+// Copyright TinyAlmonds (Alex Noerdemann)
+
+#include "Core/Types/PLSplineLookupTable.h"
+
+#include "Components/SplineComponent.h"
+
+namespace
+{
+	/** Tolerance of the spline length, in which a baked table is still valid for a spline [uu]. */
+	constexpr float SplineLengthTolerance{1.0f};
+
+	/** Number of quantization steps of a full circle of the yaw. */
+	constexpr float YawSteps{65536.0f};
+}
+
+void FPLSplineLookupTable::Bake(const USplineComponent &Spline, float MaxSampleSpacing)
+{
+	Reset();
+
+	SplineLength = Spline.GetSplineLength();
+	NumSplinePoints = Spline.GetNumberOfSplinePoints();
+	bClosedLoop = Spline.IsClosedLoop();
+
+	const int32 NumSamples{FMath::Max(2, FMath::CeilToInt32(SplineLength / FMath::Max(MaxSampleSpacing, UE_KINDA_SMALL_NUMBER)) + 1)};
+	SampleSpacing = SplineLength / (NumSamples - 1);
+
+	TArray<FVector> Locations{};
+	TArray<FVector> Directions{};
+	Locations.Reserve(NumSamples);
+	Directions.Reserve(NumSamples);
+	FBox Bounds{ForceInit};
+	for (int32 SampleIndex = 0; SampleIndex < NumSamples; ++SampleIndex)
+	{
+		const float Distance{SampleIndex * SampleSpacing};
+		Locations.Add(Spline.GetLocationAtDistanceAlongSpline(Distance, ESplineCoordinateSpace::Local));
+		Directions.Add(Spline.GetDirectionAtDistanceAlongSpline(Distance, ESplineCoordinateSpace::Local));
+		Bounds += Locations.Last();
+	}
+
+	// every axis uses the full uint16 range, a flat axis still needs a valid step
+	LocationOrigin = Bounds.Min;
+	LocationStep = (Bounds.Max - Bounds.Min) / static_cast<double>(TNumericLimits<uint16>::Max());
+	LocationStep = LocationStep.ComponentMax(FVector{UE_KINDA_SMALL_NUMBER});
+
+	QuantizedLocations.Reserve(NumSamples * 3);
+	QuantizedDirections.Reserve(NumSamples * 3);
+	QuantizedYaws.Reserve(NumSamples);
+	for (int32 SampleIndex = 0; SampleIndex < NumSamples; ++SampleIndex)
+	{
+		const FVector QuantizedLocation{(Locations[SampleIndex] - LocationOrigin) / LocationStep};
+		const FVector &Direction = Directions[SampleIndex];
+		for (int32 Axis = 0; Axis < 3; ++Axis)
+		{
+			QuantizedLocations.Add(static_cast<uint16>(FMath::Clamp(FMath::RoundToInt32(QuantizedLocation[Axis]), 0, TNumericLimits<uint16>::Max())));
+			QuantizedDirections.Add(static_cast<int16>(FMath::RoundToInt32(FMath::Clamp(Direction[Axis], -1.0, 1.0) * TNumericLimits<int16>::Max())));
+		}
+
+		const float Yaw{static_cast<float>(FRotator::ClampAxis(Direction.Rotation().Yaw))};
+		QuantizedYaws.Add(static_cast<uint16>(FMath::RoundToInt32(Yaw / 360.0f * YawSteps) & 0xFFFF));
+	}
+}
+
+void FPLSplineLookupTable::Reset()
+{
+	SplineLength = 0.0f;
+	SampleSpacing = 0.0f;
+	NumSplinePoints = 0;
+	bClosedLoop = false;
+	QuantizedLocations.Reset();
+	QuantizedDirections.Reset();
+	QuantizedYaws.Reset();
+}
+
+bool FPLSplineLookupTable::IsValidFor(const USplineComponent &Spline) const
+{
+	return (GetNumSamples() >= 2) && (NumSplinePoints == Spline.GetNumberOfSplinePoints()) && (bClosedLoop == Spline.IsClosedLoop()) &&
+		   FMath::IsNearlyEqual(SplineLength, Spline.GetSplineLength(), SplineLengthTolerance);
+}
+
+float FPLSplineLookupTable::GetSplineLength() const
+{
+	return SplineLength;
+}
+
+FVector FPLSplineLookupTable::GetLocationAtDistance(float Distance, const FTransform &SplineTransform) const
+{
+	int32 SampleIndex{0};
+	float Alpha{0.0f};
+	GetSampleInterval(Distance, SampleIndex, Alpha);
+
+	return SplineTransform.TransformPosition(FMath::Lerp(GetSampleLocation(SampleIndex), GetSampleLocation(SampleIndex + 1), Alpha));
+}
+
+FVector FPLSplineLookupTable::GetDirectionAtDistance(float Distance, const FTransform &SplineTransform) const
+{
+	int32 SampleIndex{0};
+	float Alpha{0.0f};
+	GetSampleInterval(Distance, SampleIndex, Alpha);
+
+	return SplineTransform.TransformVectorNoScale(FMath::Lerp(GetSampleDirection(SampleIndex), GetSampleDirection(SampleIndex + 1), Alpha)).GetSafeNormal();
+}
+
+float FPLSplineLookupTable::GetYawAtDistance(float Distance, const FTransform &SplineTransform) const
+{
+	int32 SampleIndex{0};
+	float Alpha{0.0f};
+	GetSampleInterval(Distance, SampleIndex, Alpha);
+
+	// interpolate along the shorter arc between the yaws of the samples
+	const float Yaw{GetSampleYaw(SampleIndex)};
+	const float LocalYaw{Yaw + FRotator::NormalizeAxis(GetSampleYaw(SampleIndex + 1) - Yaw) * Alpha};
+	return static_cast<float>(FRotator::NormalizeAxis(LocalYaw + SplineTransform.Rotator().Yaw));
+}
+
+float FPLSplineLookupTable::FindDistanceClosestToLocation(const FVector &WorldLocation, const FTransform &SplineTransform) const
+{
+	const int32 NumSamples{GetNumSamples()};
+	if (NumSamples < 2)
+	{
+		return 0.0f;
+	}
+
+	int32 ClosestSegment{0};
+	return FindDistanceClosestToLocalLocation(SplineTransform.InverseTransformPosition(WorldLocation), 0, NumSamples - 1, ClosestSegment);
+}
+
+float FPLSplineLookupTable::FindDistanceClosestToLocation(const FVector &WorldLocation, const FTransform &SplineTransform, float StartDistance, float SearchDistance) const
+{
+	const int32 NumSamples{GetNumSamples()};
+	if ((NumSamples < 2) || (SampleSpacing <= 0.0f))
+	{
+		return 0.0f;
+	}
+
+	const int32 NumSegments{NumSamples - 1};
+	const int32 NumSearchedSegments{2 * FMath::CeilToInt32(SearchDistance / SampleSpacing) + 1};
+	if (NumSearchedSegments >= NumSegments)
+	{
+		return FindDistanceClosestToLocation(WorldLocation, SplineTransform);
+	}
+
+	int32 StartSegment{0};
+	float StartAlpha{0.0f};
+	GetSampleInterval(StartDistance, StartSegment, StartAlpha);
+	int32 FirstSegment{StartSegment - (NumSearchedSegments / 2)};
+	if (!bClosedLoop)
+	{
+		FirstSegment = FMath::Clamp(FirstSegment, 0, NumSegments - NumSearchedSegments);
+	}
+
+	int32 ClosestSegment{0};
+	const FVector LocalLocation{SplineTransform.InverseTransformPosition(WorldLocation)};
+	const float ClosestDistance{FindDistanceClosestToLocalLocation(LocalLocation, FirstSegment, NumSearchedSegments, ClosestSegment)};
+
+	// the closest location may lie outside of the searched part, if it was found on the border (except on the ends of an open spline)
+	const bool bOnFirstBorder{(ClosestSegment == 0) && (bClosedLoop || (FirstSegment > 0))};
+	const bool bOnLastBorder{(ClosestSegment == (NumSearchedSegments - 1)) && (bClosedLoop || ((FirstSegment + NumSearchedSegments) < NumSegments))};
+	if (bOnFirstBorder || bOnLastBorder)
+	{
+		return FindDistanceClosestToLocalLocation(LocalLocation, 0, NumSegments, ClosestSegment);
+	}
+
+	return ClosestDistance;
+}
+
+SIZE_T FPLSplineLookupTable::GetAllocatedSize() const
+{
+	return QuantizedLocations.GetAllocatedSize() + QuantizedDirections.GetAllocatedSize() + QuantizedYaws.GetAllocatedSize();
+}
+
+float FPLSplineLookupTable::FindDistanceClosestToLocalLocation(const FVector &LocalLocation, int32 FirstSegment, int32 NumSegments, int32 &OutClosestSegment) const
+{
+	// the samples are close enough to approximate the spline by the segments between them
+	const int32 NumSplineSegments{GetNumSamples() - 1};
+	double ClosestDistanceSquared{TNumericLimits<double>::Max()};
+	float ClosestDistanceAlongSpline{0.0f};
+	OutClosestSegment = 0;
+	for (int32 SearchedSegment = 0; SearchedSegment < NumSegments; ++SearchedSegment)
+	{
+		const int32 SegmentIndex{((FirstSegment + SearchedSegment) % NumSplineSegments + NumSplineSegments) % NumSplineSegments};
+		const FVector SegmentStart{GetSampleLocation(SegmentIndex)};
+		const FVector SegmentEnd{GetSampleLocation(SegmentIndex + 1)};
+		const FVector ClosestPoint{FMath::ClosestPointOnSegment(LocalLocation, SegmentStart, SegmentEnd)};
+		const double DistanceSquared{FVector::DistSquared(LocalLocation, ClosestPoint)};
+		if (DistanceSquared < ClosestDistanceSquared)
+		{
+			const double SegmentLength{FVector::Dist(SegmentStart, SegmentEnd)};
+			const double Alpha{(SegmentLength > UE_KINDA_SMALL_NUMBER) ? (FVector::Dist(SegmentStart, ClosestPoint) / SegmentLength) : 0.0};
+			ClosestDistanceSquared = DistanceSquared;
+			ClosestDistanceAlongSpline = static_cast<float>((SegmentIndex + Alpha) * SampleSpacing);
+			OutClosestSegment = SearchedSegment;
+		}
+	}
+
+	return ClosestDistanceAlongSpline;
+}
+
+void FPLSplineLookupTable::GetSampleInterval(float Distance, int32 &OutIndex, float &OutAlpha) const
+{
+	const int32 NumSamples{GetNumSamples()};
+	if ((NumSamples < 2) || (SampleSpacing <= 0.0f))
+	{
+		OutIndex = 0;
+		OutAlpha = 0.0f;
+		return;
+	}
+
+	if (bClosedLoop)
+	{
+		Distance = FMath::Fmod(Distance, SplineLength);
+		Distance = (Distance < 0.0f) ? (Distance + SplineLength) : Distance;
+	}
+	else
+	{
+		Distance = FMath::Clamp(Distance, 0.0f, SplineLength);
+	}
+
+	const float SamplePosition{Distance / SampleSpacing};
+	OutIndex = FMath::Clamp(FMath::FloorToInt32(SamplePosition), 0, NumSamples - 2);
+	OutAlpha = FMath::Clamp(SamplePosition - OutIndex, 0.0f, 1.0f);
+}
+
+FVector FPLSplineLookupTable::GetSampleLocation(int32 SampleIndex) const
+{
+	const int32 Offset{SampleIndex * 3};
+	return LocationOrigin + FVector{static_cast<double>(QuantizedLocations[Offset]), static_cast<double>(QuantizedLocations[Offset + 1]), static_cast<double>(QuantizedLocations[Offset + 2])} * LocationStep;
+}
+
+FVector FPLSplineLookupTable::GetSampleDirection(int32 SampleIndex) const
+{
+	const int32 Offset{SampleIndex * 3};
+	return FVector{static_cast<double>(QuantizedDirections[Offset]), static_cast<double>(QuantizedDirections[Offset + 1]), static_cast<double>(QuantizedDirections[Offset + 2])} / TNumericLimits<int16>::Max();
+}
+
+float FPLSplineLookupTable::GetSampleYaw(int32 SampleIndex) const
+{
+	return QuantizedYaws[SampleIndex] * (360.0f / YawSteps);
+}
+
+int32 FPLSplineLookupTable::GetNumSamples() const
+{
+	return QuantizedYaws.Num();
+}
@@ -15,6 +15,15 @@ public class ProjectLux : ModuleRules
 		// Dependencies for the "Gameplay Ability System" plugin
 		PrivateDependencyModuleNames.AddRange(new string[] { "GameplayAbilities", "GameplayTags", "GameplayTasks" });
 
+		// Dependencies for the blackboards of the enemy AI
+		PrivateDependencyModuleNames.AddRange(new string[] { "AIModule" });
+
+		// Dependencies for the machine-readable output of the benchmark commandlets
+		PrivateDependencyModuleNames.AddRange(new string[] { "Json" });
+
+		// Dependencies for the default GameMode of the benchmark commandlets
+		PrivateDependencyModuleNames.AddRange(new string[] { "EngineSettings" });
+
 		// Uncomment if you are using Slate UI
 		// PrivateDependencyModuleNames.AddRange(new string[] { "Slate", "SlateCore" });
 
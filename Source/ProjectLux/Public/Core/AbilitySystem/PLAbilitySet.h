@@ -0,0 +1,82 @@
+// Copyright TinyAlmonds (Alex Noerdemann)
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "Engine/StreamableManager.h"
+#include "GameplayAbilitySpec.h"
+
+#include "PLAbilitySet.generated.h"
+
+// Forward declarations
+class UAbilitySystemComponent;
+class UGameplayAbility;
+class UGameplayEffect;
+
+/**
+ * Data asset holding a bundle of GameplayAbilities and initialization GameplayEffects (e.g. movement, combat or an enemy archetype).
+ * The abilities and effects are soft references, so that they are only loaded (through the streamable manager of the UAssetManager) by characters and maps using the set.
+ */
+UCLASS(BlueprintType)
+class PROJECTLUX_API UPLAbilitySet : public UPrimaryDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	/** GameplayAbilities given by this set. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Abilities")
+	TArray<TSoftClassPtr<UGameplayAbility>> Abilities;
+
+	/** Passive GameplayAbilities given and activated by this set. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Abilities")
+	TArray<TSoftClassPtr<UGameplayAbility>> PassiveAbilities;
+
+	/** Instant GameplayEffects applied by this set to initialize the AttributeSets. Applied in order after the abilities were given. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Abilities")
+	TArray<TSoftClassPtr<UGameplayEffect>> AttributeSetInitEffects;
+
+	/**
+	 * Gives the abilities, activates the passive abilities and applies the initialization effects of this set to the given ASC.
+	 * Classes, which are not loaded yet, are loaded blocking as fallback. The blocking load time is logged as warning.
+	 * @param AbilitySystemComponent - The ASC to give the abilities to.
+	 * @param SourceObject - The source object of the ability specs and effect contexts.
+	 * @param OutPassiveAbilitySpecHandles - The handles of the given passive abilities are appended.
+	 */
+	void GiveToAbilitySystem(UAbilitySystemComponent &AbilitySystemComponent, UObject *SourceObject, TArray<FGameplayAbilitySpecHandle> &OutPassiveAbilitySpecHandles) const;
+
+	/**
+	 * Appends the paths of all classes referenced by this set.
+	 * @param OutPaths - The paths are appended.
+	 */
+	void GetSoftObjectPaths(TArray<FSoftObjectPath> &OutPaths) const;
+
+	/**
+	 * Checks, whether all classes referenced by this set are loaded.
+	 * @return True if all classes are loaded; False otherwise.
+	 */
+	bool IsLoaded() const;
+
+	/**
+	 * Requests the asynchronous load of all classes referenced by the given sets. The load time is logged on completion.
+	 * @param AbilitySets - The sets to load. nullptr entries are skipped.
+	 * @param OnLoaded - Called on the game thread, when all classes are loaded. Also called (immediately), if nothing has to be loaded.
+	 * @return The handle of the request, which has to be kept to keep the classes loaded. nullptr, if nothing has to be loaded.
+	 */
+	static TSharedPtr<FStreamableHandle> LoadAbilitySetsAsync(const TArray<UPLAbilitySet *> &AbilitySets, FStreamableDelegate OnLoaded);
+
+	/**
+	 * Creates a set from the deprecated ability and initialization effect properties of a character (e.g. in PostLoad(), until the assets are resaved with sets).
+	 * The set is created inside the given owner, so that it is saved with the owner's package.
+	 * @param Owner - The owner of the deprecated properties.
+	 * @param DeprecatedAbilities - The deprecated default abilities.
+	 * @param DeprecatedPassiveAbilities - The deprecated default passive abilities.
+	 * @param DeprecatedAttributeSetInitEffects - The deprecated initialization effects in the order of their application. nullptr entries are skipped.
+	 * @return The created set; nullptr if all properties are empty.
+	 */
+	static UPLAbilitySet *CreateFromDeprecatedProperties(UObject &Owner, const TArray<TSubclassOf<UGameplayAbility>> &DeprecatedAbilities, const TArray<TSubclassOf<UGameplayAbility>> &DeprecatedPassiveAbilities,
+														 const TArray<TSubclassOf<UGameplayEffect>> &DeprecatedAttributeSetInitEffects);
+
+private:
+	/** Loads all classes referenced by this set blocking, which are not loaded yet. */
+	void LoadSynchronous() const;
+};
@@ -3,6 +3,8 @@
 
 #include "AbilitySystemComponent.h"
 #include "CoreMinimal.h"
+#include "Engine/TimerHandle.h"
+#include "UObject/ObjectKey.h"
 
 #include "PLAbilitySystemComponent.generated.h"
 
@@ -31,4 +33,189 @@ public:
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Abilities")
 	virtual UGameplayAbility *ActivateAbilityOfClass(const TSubclassOf<UGameplayAbility> &InAbilityToActivate, bool &OutIsInstance);
+
+	/**
+	 * Returns the spec of the given ability class in constant time (instead of scanning the activatable abilities).
+	 * @param AbilityClass - The ability class to look up.
+	 * @return The first given spec of the class; nullptr if the class was not given.
+	 */
+	FGameplayAbilitySpec *FindAbilitySpecFromClassCached(const TSubclassOf<UGameplayAbility> &AbilityClass);
+
+	/**
+	 * Checks, whether the ability of the given spec can be activated. The result is memoized for the current frame, until a GameplayTag, a blocked ability tag, an attribute,
+	 * the given abilities or the active abilities change. Since cooldowns are checked by their granted tags, a started or ended cooldown also invalidates the results.
+	 * Within a frame, CanActivate (including Blueprint overrides) may only depend on the state of the ASC. State outside of the ASC (e.g. the movement mode, the velocity,
+	 * the wall slide flag or the distance to a target) is only reevaluated in the next frame; call InvalidateActivationCache() when it changes within the frame.
+	 * @param AbilitySpec - The spec to check.
+	 * @return True if the ability can be activated; False otherwise.
+	 */
+	bool CanActivateAbilityCached(const FGameplayAbilitySpec &AbilitySpec);
+
+	/**
+	 * Tries to activate all abilities matching the given tags like TryActivateAbilitiesByTag(), but skips abilities with a memoized negative result of CanActivateAbilityCached().
+	 * Abilities without a memoized result are checked only once by the activation itself; a failed activation is memoized as negative result for the current frame.
+	 * @param GameplayTagContainer - The tags the abilities have to match.
+	 * @return True if at least one ability was activated; False otherwise.
+	 */
+	bool TryActivateAbilitiesByTagCached(const FGameplayTagContainer &GameplayTagContainer);
+
+	/** Invalidates all memoized activation results. */
+	void InvalidateActivationCache();
+
+	/**
+	 * Starts a cooldown, which adds the given tag as loose GameplayTag until the duration elapsed. Replaces a cooldown GameplayEffect for abilities used at high frequency (e.g. Dash).
+	 * Starting a running cooldown again restarts it.
+	 * @param CooldownTag - The tag granted during the cooldown (e.g. Cooldown.Ability.Movement.Dash).
+	 * @param Duration - The duration of the cooldown [s].
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Abilities|Cooldown")
+	void StartAbilityCooldown(FGameplayTag CooldownTag, float Duration);
+
+	/**
+	 * Adds the given tag as loose GameplayTag until the avatar lands again. Replaces a "blocked until on ground again" GameplayEffect. Ignored, if the avatar is not falling.
+	 * @param BlockTag - The tag granted until the landing (e.g. GameplayEffect.Movement.Dash.BlockedUntilOnGroundAgain).
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Abilities|Cooldown")
+	void BlockAbilityUntilGrounded(FGameplayTag BlockTag);
+
+	/**
+	 * Returns the remaining time of the cooldown with the given tag.
+	 * @param CooldownTag - The tag of the cooldown.
+	 * @return The remaining time [s]; 0 if the cooldown is not running.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Abilities|Cooldown")
+	float GetAbilityCooldownTimeRemaining(FGameplayTag CooldownTag) const;
+
+	/** Removes the tags of all abilities blocked until the landing. Called by the UPLCharacterMovementComponent, when the avatar lands. */
+	void NotifyLanded();
+
+	/** Removes all cooldowns and blocks (e.g. on respawn). */
+	UFUNCTION(BlueprintCallable, Category = "Abilities|Cooldown")
+	void ClearAbilityBlocks();
+
+	/** Binds the invalidation of the activation cache to the attributes of the spawned AttributeSets. */
+	virtual void InitAbilityActorInfo(AActor *InOwnerActor, AActor *InAvatarActor) override;
+
+	/** Tracks the applied GameplayEffect instances by the AbilitySystem tag of the low level memory tracker. */
+	virtual FActiveGameplayEffectHandle ApplyGameplayEffectSpecToSelf(const FGameplayEffectSpec &GameplayEffect, FPredictionKey PredictionKey = FPredictionKey()) override;
+
+	/**
+	 * Returns the memory allocated by the caches of the project (spec index, activation cache and ability blocks), e.g. for the memory report.
+	 * @return The allocated size [bytes].
+	 */
+	SIZE_T GetCacheAllocatedSize() const;
+
+protected:
+	/** Adds the given spec to the index, if it is the first spec of its class. */
+	virtual void OnGiveAbility(FGameplayAbilitySpec &AbilitySpec) override;
+
+	/** Removes the given spec from the index and indexes the next spec of the same class, if available. */
+	virtual void OnRemoveAbility(FGameplayAbilitySpec &AbilitySpec) override;
+
+	/** Invalidates the activation cache, when a GameplayTag is added or removed. */
+	virtual void OnTagUpdated(const FGameplayTag &Tag, bool TagExists) override;
+
+	/** Invalidates the activation cache, since an active ability may block its own or other activations. */
+	virtual void NotifyAbilityActivated(const FGameplayAbilitySpecHandle Handle, UGameplayAbility *Ability) override;
+
+	/** Invalidates the activation cache, since the ended ability may have blocked its own or other activations. */
+	virtual void NotifyAbilityEnded(FGameplayAbilitySpecHandle Handle, UGameplayAbility *Ability, bool bWasCancelled) override;
+
+private:
+	/** Indexed spec of an ability class. */
+	struct FPLAbilitySpecIndexEntry
+	{
+		/** The handle of the spec. */
+		FGameplayAbilitySpecHandle Handle;
+
+		/** Index of the spec in ActivatableAbilities.Items, when it was last found. Validated by the handle on every lookup. */
+		int32 ItemIndex{INDEX_NONE};
+	};
+
+	/** A cooldown or a block until the landing, which grants its tag as loose GameplayTag. */
+	struct FPLAbilityBlock
+	{
+		/** The granted tag. */
+		FGameplayTag Tag;
+
+		/** World time at which the cooldown ends [s]. Unused, if the block lasts until the landing. */
+		double EndTime{0.0};
+
+		/** Whether the block lasts until the landing instead of the EndTime. */
+		bool bUntilGrounded{false};
+	};
+
+	/** Number of blocks, which are tracked without a heap allocation. */
+	static constexpr int32 NumInlineAbilityBlocks{8};
+
+	/**
+	 * Adds the given block and its loose GameplayTag. An existing block with the same tag is replaced without adding the tag again.
+	 * @param Block - The block to add.
+	 */
+	void AddAbilityBlock(const FPLAbilityBlock &Block);
+
+	/**
+	 * Removes the blocks matching the given predicate and their loose GameplayTags.
+	 * @param Predicate - Returns True for the blocks to remove.
+	 */
+	void RemoveAbilityBlocks(TFunctionRef<bool(const FPLAbilityBlock &)> Predicate);
+
+	/** Removes the elapsed cooldowns and schedules the timer for the next ending cooldown. */
+	void UpdateAbilityCooldowns();
+
+	/** Memoized result of CanActivateAbilityCached(). */
+	struct FPLActivationCacheEntry
+	{
+		/** The frame the result was determined in. */
+		uint64 FrameCounter{0};
+
+		/** The ActivationCacheGeneration the result was determined in. */
+		uint32 Generation{0};
+
+		/** Whether the ability can be activated. */
+		bool bCanActivate{false};
+	};
+
+	/**
+	 * Invalidates the activation cache, when an attribute changes.
+	 * @param Data - The attribute change. Unused, only for interface compliance.
+	 */
+	void OnAttributeChangedForActivationCache(const FOnAttributeChangeData &Data);
+
+	/**
+	 * Invalidates the activation cache, when a blocked ability tag is added or removed (e.g. by the block tags of an ability or UnBlockAbilitiesWithTags()).
+	 * @param Tag - The changed tag. Unused, only for interface compliance.
+	 * @param NewCount - The new count of the tag. Unused, only for interface compliance.
+	 */
+	void OnBlockedAbilityTagChanged(const FGameplayTag Tag, int32 NewCount);
+
+	/**
+	 * Returns the memoized result of the given spec, if it is valid for the current frame and ActivationCacheGeneration.
+	 * @param AbilitySpec - The spec to look up.
+	 * @param bOutCanActivate - The memoized result. Only valid, if True is returned.
+	 * @return True if a valid result is memoized; False otherwise.
+	 */
+	bool FindActivationCacheResult(const FGameplayAbilitySpec &AbilitySpec, bool &bOutCanActivate) const;
+
+	/**
+	 * Memoizes the given result of the given spec for the current frame and ActivationCacheGeneration.
+	 * @param AbilitySpecHandle - The handle of the spec.
+	 * @param bCanActivate - The result to memoize.
+	 */
+	void SetActivationCacheResult(FGameplayAbilitySpecHandle AbilitySpecHandle, bool bCanActivate);
+
+	/** The spec of every given ability class. */
+	TMap<TObjectKey<UClass>, FPLAbilitySpecIndexEntry> AbilitySpecIndex;
+
+	/** The memoized activation results by spec. */
+	TMap<FGameplayAbilitySpecHandle, FPLActivationCacheEntry> ActivationCache;
+
+	/** The active cooldowns and blocks until the landing. */
+	TArray<FPLAbilityBlock, TInlineAllocator<NumInlineAbilityBlocks>> AbilityBlocks;
+
+	/** Timer of the next ending cooldown. */
+	FTimerHandle AbilityCooldownTimerHandle;
+
+	/** Generation of the activation cache. Incremented on every invalidation, so that older results are ignored. */
+	uint32 ActivationCacheGeneration{0};
 };
@@ -0,0 +1,74 @@
+// Copyright TinyAlmonds (Alex Noerdemann)
+#pragma once
+
+#include "AttributeSet.h"
+#include "CoreMinimal.h"
+#include "GameplayEffectTypes.h"
+#include "GameplayTagContainer.h"
+
+// Forward declarations
+class UAbilitySystemComponent;
+
+/**
+ * Bindings of an owner (e.g. a character) to the attribute and GameplayTag delegates of an AbilitySystemComponent.
+ * The handles of all bindings are stored, so that the owner can remove exactly its own bindings (e.g. on unpossession) and repeated possessions do not pile up duplicate callbacks.
+ */
+struct PROJECTLUX_API FPLAbilitySystemDelegateBindings
+{
+	/**
+	 * Binds the given delegate to the value changes of the given attribute.
+	 * @param InAbilitySystemComponent - The ASC owning the attribute. Bindings to a previous ASC are removed.
+	 * @param Attribute - The attribute to observe.
+	 * @param Delegate - The delegate to call on value changes.
+	 */
+	void BindAttributeValueChange(UAbilitySystemComponent &InAbilitySystemComponent, const FGameplayAttribute &Attribute, FOnGameplayAttributeValueChange::FDelegate Delegate);
+
+	/**
+	 * Binds the given delegate to the count changes of the given GameplayTag.
+	 * @param InAbilitySystemComponent - The ASC owning the tag counts. Bindings to a previous ASC are removed.
+	 * @param Tag - The GameplayTag to observe.
+	 * @param EventType - The type of the count changes to observe.
+	 * @param Delegate - The delegate to call on count changes.
+	 */
+	void BindGameplayTagEvent(UAbilitySystemComponent &InAbilitySystemComponent, const FGameplayTag &Tag, EGameplayTagEventType::Type EventType, FOnGameplayEffectTagCountChanged::FDelegate Delegate);
+
+	/** Removes all bindings from the ASC. Bindings of an already destroyed ASC are only forgotten. */
+	void UnbindAll();
+
+	/**
+	 * Returns the number of active bindings.
+	 * @return The number of active bindings.
+	 */
+	int32 Num() const;
+
+private:
+	/** A binding to the value changes of an attribute. */
+	struct FAttributeBinding
+	{
+		FGameplayAttribute Attribute;
+		FDelegateHandle Handle;
+	};
+
+	/** A binding to the count changes of a GameplayTag. */
+	struct FGameplayTagBinding
+	{
+		FGameplayTag Tag;
+		EGameplayTagEventType::Type EventType{EGameplayTagEventType::NewOrRemoved};
+		FDelegateHandle Handle;
+	};
+
+	/**
+	 * Removes the bindings, if they belong to another ASC than the given one.
+	 * @param NewAbilitySystemComponent - The ASC of the next binding.
+	 */
+	void SetAbilitySystemComponent(UAbilitySystemComponent &NewAbilitySystemComponent);
+
+	/** The ASC, which owns the bound delegates. */
+	TWeakObjectPtr<UAbilitySystemComponent> AbilitySystemComponent;
+
+	/** The bindings to attribute value changes. */
+	TArray<FAttributeBinding, TInlineAllocator<4>> AttributeBindings;
+
+	/** The bindings to GameplayTag count changes. */
+	TArray<FGameplayTagBinding, TInlineAllocator<4>> GameplayTagBindings;
+};
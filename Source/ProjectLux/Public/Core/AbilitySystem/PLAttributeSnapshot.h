@@ -0,0 +1,40 @@
+// Copyright TinyAlmonds (Alex Noerdemann)
+#pragma once
+
+#include "AttributeSet.h"
+#include "CoreMinimal.h"
+
+// Forward declarations
+class UAbilitySystemComponent;
+
+/**
+ * Snapshot of the base values of all attributes of an AbilitySystemComponent (e.g. after the initialization effects were applied).
+ * Restoring the snapshot resets the attributes without applying the initialization effects again.
+ */
+struct PROJECTLUX_API FPLAttributeSnapshot
+{
+	/** The captured attributes. Limiting attributes (e.g. MaxHealth) are ordered before the attributes they clamp. */
+	TArray<FGameplayAttribute> Attributes;
+
+	/** The base values of the captured attributes (same order as Attributes). */
+	TArray<float> BaseValues;
+
+	/**
+	 * Captures the base values of all attributes of the attribute sets of the given ASC.
+	 * @param AbilitySystemComponent - The ASC to capture.
+	 * @return The snapshot of the attributes.
+	 */
+	static FPLAttributeSnapshot Capture(const UAbilitySystemComponent &AbilitySystemComponent);
+
+	/**
+	 * Sets the base values of the given ASC to the captured values.
+	 * @param AbilitySystemComponent - The ASC to restore. Attributes unknown to the ASC are skipped.
+	 */
+	void Restore(UAbilitySystemComponent &AbilitySystemComponent) const;
+
+	/**
+	 * Checks, whether the snapshot holds any attribute.
+	 * @return True if no attribute was captured; False otherwise.
+	 */
+	bool IsEmpty() const;
+};
@@ -0,0 +1,25 @@
+// Copyright TinyAlmonds (Alex Noerdemann)
+#pragma once
+
+#include "CoreMinimal.h"
+#include "NativeGameplayTags.h"
+
+/**
+ * Native GameplayTags used by the C++ code. The tags are registered on module startup, so that no tag has to be requested by its name at runtime
+ * and a typo fails at startup instead of silently at runtime. The tags match the tags of the DefaultGameplayTags.ini.
+ */
+namespace PLGameplayTags
+{
+	PROJECTLUX_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Ability_Combat_Attack);
+	PROJECTLUX_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Ability_Movement_Dash);
+	PROJECTLUX_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Ability_Movement_DoubleDash);
+	PROJECTLUX_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Ability_Movement_Glide);
+	PROJECTLUX_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Ability_Movement_QuickStep);
+	PROJECTLUX_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Ability_Movement_Sprint);
+	PROJECTLUX_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Ability_Movement_WallJump);
+	PROJECTLUX_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Ability_Movement_WallSlide);
+	PROJECTLUX_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Cooldown);
+	PROJECTLUX_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(GameplayEffect_Damage_MeleeSwing);
+	PROJECTLUX_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Reject_MoveInput);
+	PROJECTLUX_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Status_Dead);
+}
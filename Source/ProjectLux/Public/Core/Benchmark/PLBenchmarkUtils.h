@@ -0,0 +1,91 @@
+// Copyright TinyAlmonds (Alex Noerdemann)
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Forward declarations
+class FJsonObject;
+class UWorld;
+
+/**
+ * Statistics of a series of benchmark samples (e.g. frame times), including percentiles.
+ */
+struct PROJECTLUX_API FPLBenchmarkSampleStatistics
+{
+	double Mean{0.0};
+	double Min{0.0};
+	double Max{0.0};
+	double P50{0.0};
+	double P90{0.0};
+	double P99{0.0};
+
+	/**
+	 * Calculates the statistics of the given samples.
+	 * @param Samples - The samples to evaluate. The array is sorted in place.
+	 * @return The statistics of the samples. All values are zero, if no samples were given.
+	 */
+	static FPLBenchmarkSampleStatistics FromSamples(TArray<double> &Samples);
+
+	/**
+	 * Converts the statistics into a JSON object (keys: mean, min, max, p50, p90, p99).
+	 * @return The JSON object holding the statistics.
+	 */
+	TSharedRef<FJsonObject> ToJson() const;
+};
+
+/**
+ * Scope which counts the heap allocations made through GMalloc while it is alive.
+ * @note The counting allocator forwards to the allocator which was active on construction, so allocations made inside the scope can safely be freed outside of it.
+ * @note Only meant for benchmark commandlets, since swapping GMalloc while other systems allocate concurrently is not free of side effects.
+ */
+class PROJECTLUX_API FPLScopedAllocationCounter
+{
+public:
+	FPLScopedAllocationCounter();
+	~FPLScopedAllocationCounter();
+
+	FPLScopedAllocationCounter(const FPLScopedAllocationCounter &) = delete;
+	FPLScopedAllocationCounter &operator=(const FPLScopedAllocationCounter &) = delete;
+
+	/** Returns the number of allocations (Malloc and Realloc of a nullptr) since construction or the last Reset(). */
+	uint64 GetNumAllocations() const;
+
+	/** Returns the number of bytes requested by allocations since construction or the last Reset(). */
+	uint64 GetNumAllocatedBytes() const;
+
+	/** Resets the counters to zero. */
+	void Reset();
+
+private:
+	/** The allocator active before the scope was entered. Restored on destruction. */
+	FMalloc *PreviousMalloc{nullptr};
+
+	/** Counter values at the last Reset(). */
+	uint64 NumAllocationsAtReset{0};
+	uint64 NumAllocatedBytesAtReset{0};
+};
+
+namespace PLBenchmarkUtils
+{
+	/**
+	 * Creates an empty game world with its own world context and dispatches BeginPlay, so that spawned actors behave like in a running game.
+	 * @param WorldName - The name of the world.
+	 * @return The created world. Has to be destroyed with DestroyWorld().
+	 */
+	PROJECTLUX_API UWorld *CreateWorld(FName WorldName);
+
+	/**
+	 * Destroys a world created with CreateWorld() together with its world context.
+	 * @param World - The world to destroy.
+	 */
+	PROJECTLUX_API void DestroyWorld(UWorld *World);
+
+	/**
+	 * Writes the given JSON object to the given file and to the log.
+	 * @param JsonObject - The result of the benchmark.
+	 * @param OutputFilePath - Path of the file to write. If empty, "Saved/Benchmarks/<DefaultFileName>.json" is used.
+	 * @param DefaultFileName - The file name used, if no OutputFilePath is given.
+	 * @return True if the file was written; False otherwise.
+	 */
+	PROJECTLUX_API bool WriteResult(const TSharedRef<FJsonObject> &JsonObject, const FString &OutputFilePath, const FString &DefaultFileName);
+}
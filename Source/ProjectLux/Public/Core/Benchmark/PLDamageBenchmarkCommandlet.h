@@ -0,0 +1,74 @@
+// Copyright TinyAlmonds (Alex Noerdemann)
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+#include "CoreMinimal.h"
+
+#include "PLDamageBenchmarkCommandlet.generated.h"
+
+// Forward declarations
+class UAbilitySystemComponent;
+class UGameplayEffect;
+class UPLCharacterAttributeSet;
+struct FRandomStream;
+
+/**
+ * Microbenchmark and correctness fuzz harness for the UPLAttackDamageExecution and the attribute clamping of UPLCharacterAttributeSet.
+ * Builds GameplayEffect specs against synthetic source and target characters, runs them and reports throughput and allocations as JSON.
+ * Afterwards the attribute values are fuzzed to check that all results stay finite and clamped.
+ *
+ * Usage: UnrealEditor-Cmd ProjectLux.uproject -run=PLDamageBenchmark -nullrhi -unattended [-Executions=1000000] [-FuzzIterations=100000]
+ *        [-Seed=0] [-Output=<FilePath>]
+ */
+UCLASS()
+class PROJECTLUX_API UPLDamageBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UPLDamageBenchmarkCommandlet();
+
+	/**
+	 * Runs the benchmark and the fuzzing.
+	 * @param Params - The command line parameters of the commandlet.
+	 * @return 0 on success; 1 if the fuzzing found violations or the result could not be written.
+	 */
+	virtual int32 Main(const FString &Params) override;
+
+private:
+	/**
+	 * Fuzzes the clamping of the attribute set by passing random values of all attributes through PreAttributeChange().
+	 * @param RandomStream - The random stream to draw the values from.
+	 * @param AttributeSet - The attribute set to fuzz. Reset to the default values before the fuzzing, so that it can be reused across the iterations.
+	 * @param OutViolations - Descriptions of found violations are added to it.
+	 */
+	void FuzzAttributeClamping(FRandomStream &RandomStream, UPLCharacterAttributeSet &AttributeSet, TArray<FString> &OutViolations) const;
+
+	/**
+	 * Sets random attribute values on source and target, executes the damage effect and checks the resulting target attributes.
+	 * @param RandomStream - The random stream to draw the values from.
+	 * @param DamageEffect - The effect executing the UPLAttackDamageExecution.
+	 * @param SourceAbilitySystem - The ASC of the attacker.
+	 * @param TargetAbilitySystem - The ASC of the attacked character.
+	 * @param OutViolations - Descriptions of found violations are added to it.
+	 */
+	void FuzzDamageExecution(FRandomStream &RandomStream, const UGameplayEffect *DamageEffect, UAbilitySystemComponent *SourceAbilitySystem, UAbilitySystemComponent *TargetAbilitySystem, TArray<FString> &OutViolations) const;
+
+	/**
+	 * Checks the invariants of the clamped attribute values of the given attribute set.
+	 * @param AttributeSet - The attribute set to check.
+	 * @param Context - Description of the check, which is added to the violation messages.
+	 * @param OutViolations - Descriptions of found violations are added to it.
+	 */
+	static void CheckAttributeInvariants(const UPLCharacterAttributeSet &AttributeSet, const TCHAR *Context, TArray<FString> &OutViolations);
+
+	/**
+	 * Draws a random attribute value. Mostly values in gameplay range, but also extreme finite values.
+	 * @param RandomStream - The random stream to draw the value from.
+	 * @return The random value.
+	 */
+	static float DrawFuzzValue(FRandomStream &RandomStream);
+
+	/** Maximum number of violation messages written into the result. */
+	static constexpr int32 MaxReportedViolations{32};
+};
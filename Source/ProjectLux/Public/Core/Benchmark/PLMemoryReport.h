@@ -0,0 +1,125 @@
+// Copyright TinyAlmonds (Alex Noerdemann)
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Forward declarations
+class AActor;
+class FJsonObject;
+class UAbilitySystemComponent;
+class UWorld;
+
+/**
+ * Memory footprint of a character with its ability system. The UObjects are measured like "obj list" does (class size and counted container memory).
+ */
+struct PROJECTLUX_API FPLCharacterMemoryFootprint
+{
+	/** The actor and its components except the ability system [bytes]. */
+	int64 ActorBytes{0};
+
+	/** The ability system component including its ability specs and active GameplayEffects [bytes]. */
+	int64 AbilitySystemBytes{0};
+
+	/** The attribute sets of the ability system [bytes]. */
+	int64 AttributeSetBytes{0};
+
+	/** The instanced abilities of the ability specs [bytes]. */
+	int64 AbilityInstanceBytes{0};
+
+	/** The caches of the project owned by the ability system (UPLAbilitySystemComponent) [bytes]. */
+	int64 CacheBytes{0};
+
+	/** Number of ability specs. */
+	int32 NumAbilitySpecs{0};
+
+	/** Number of active GameplayEffects. */
+	int32 NumGameplayEffects{0};
+
+	/**
+	 * Measures the given character.
+	 * @param Character - The character to measure.
+	 * @param AbilitySystemComponent - The ability system of the character. The ability system is not measured, if nullptr.
+	 * @return The footprint of the character.
+	 */
+	static FPLCharacterMemoryFootprint Measure(const AActor &Character, const UAbilitySystemComponent *AbilitySystemComponent);
+
+	/**
+	 * Returns the sum of all parts.
+	 * @return The total footprint [bytes].
+	 */
+	int64 GetTotalBytes() const;
+
+	/** Adds the given footprint part by part (e.g. for the totals of all enemies). */
+	FPLCharacterMemoryFootprint &operator+=(const FPLCharacterMemoryFootprint &Other);
+
+	/**
+	 * Converts the footprint into a JSON object (keys: actorBytes, abilitySystemBytes, attributeSetBytes, abilityInstanceBytes, cacheBytes, totalBytes, abilitySpecs, gameplayEffects).
+	 * @return The JSON object holding the footprint.
+	 */
+	TSharedRef<FJsonObject> ToJson() const;
+};
+
+/**
+ * Memory report of the project in a world: the footprint of the player characters, the enemies (in total and per enemy class) and the caches owned by the project.
+ */
+struct PROJECTLUX_API FPLMemoryReport
+{
+	/** The footprint of the enemies of a class. */
+	struct FPLEnemyClassFootprint
+	{
+		/** The name of the enemy class. */
+		FString ClassName;
+
+		/** Number of enemies of the class. */
+		int32 NumEnemies{0};
+
+		/** The summed footprint of the enemies of the class. */
+		FPLCharacterMemoryFootprint Total{};
+
+		/** The largest total footprint of a single enemy of the class [bytes]. */
+		int64 MaxEnemyBytes{0};
+	};
+
+	/** Number of player characters. */
+	int32 NumCharacters{0};
+
+	/** The summed footprint of the player characters. */
+	FPLCharacterMemoryFootprint Characters{};
+
+	/** Number of enemies. */
+	int32 NumEnemies{0};
+
+	/** The summed footprint of all enemies. */
+	FPLCharacterMemoryFootprint Enemies{};
+
+	/** The footprint of the enemies per class, sorted by the total footprint (largest first). */
+	TArray<FPLEnemyClassFootprint> EnemyClasses;
+
+	/** The allocated size of every cache owned by the project (e.g. "SplineLookup") [bytes]. */
+	TArray<TPair<FString, int64>> Caches;
+
+	/**
+	 * Gathers the report of the given world.
+	 * @param World - The world to report.
+	 * @return The report.
+	 */
+	static FPLMemoryReport Gather(UWorld &World);
+
+	/**
+	 * Returns the total allocated size of the caches.
+	 * @return The size of the caches [bytes].
+	 */
+	int64 GetCacheBytes() const;
+
+	/**
+	 * Returns the total footprint of the report.
+	 * @return The footprint of characters, enemies and caches [bytes].
+	 */
+	int64 GetTotalBytes() const;
+
+	/**
+	 * Converts the report into lines of text (e.g. for the console).
+	 * @return The lines of the report.
+	 */
+	TArray<FString> ToLines() const;
+};
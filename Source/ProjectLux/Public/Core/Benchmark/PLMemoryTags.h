@@ -0,0 +1,19 @@
+// Copyright TinyAlmonds (Alex Noerdemann)
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/LowLevelMemTracker.h"
+
+/**
+ * Low level memory tracker (LLM) tags of the project, shown below "ProjectLux" in "stat LLMFULL" and "memreport -llm" (when running with -llm).
+ * The allocations of a scope are tracked by LLM_SCOPE_BYTAG(ProjectLux_...). The innermost scope wins, so e.g. the ability specs given to an enemy are tracked as AbilitySystem.
+ */
+LLM_DECLARE_TAG_API(ProjectLux, PROJECTLUX_API);
+/** The APLCharacter with its components, ability system and attribute sets. */
+LLM_DECLARE_TAG_API(ProjectLux_Character, PROJECTLUX_API);
+/** The APLEnemyCharacterBase actors with their components, ability systems and attribute sets. */
+LLM_DECLARE_TAG_API(ProjectLux_Enemies, PROJECTLUX_API);
+/** Ability specs and GameplayEffect instances. */
+LLM_DECLARE_TAG_API(ProjectLux_AbilitySystem, PROJECTLUX_API);
+/** Caches owned by the project (e.g. spline lookup tables, wall proximity grid, activation caches). */
+LLM_DECLARE_TAG_API(ProjectLux_Caches, PROJECTLUX_API);
@@ -0,0 +1,82 @@
+// Copyright TinyAlmonds (Alex Noerdemann)
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+#include "CoreMinimal.h"
+
+#include "PLMovementBenchmarkCommandlet.generated.h"
+
+// Forward declarations
+class APLCharacter;
+class APLEnemyCharacterBase;
+class USplineComponent;
+class UWorld;
+
+/**
+ * Headless benchmark, which spawns APLCharacter and APLEnemyCharacterBase instances in a generated world and drives scripted movement inputs.
+ * The per-frame cost, allocations per frame and tick time percentiles are written as JSON.
+ * Without -CharacterClass, the default pawn of the global default GameMode is used, so that the configured abilities (Dash, Glide, WallSlide) are benchmarked.
+ * If the spawned characters miss these abilities, a warning is logged and "abilitiesCovered" is False in the JSON.
+ *
+ * Usage: UnrealEditor-Cmd ProjectLux.uproject -run=PLMovementBenchmark -nullrhi -unattended [-NumCharacters=8] [-NumEnemies=32]
+ *        [-Frames=600] [-WarmupFrames=60] [-DeltaTime=0.0166667] [-CharacterClass=<ClassPath>] [-EnemyClass=<ClassPath>] [-Output=<FilePath>]
+ */
+UCLASS()
+class PROJECTLUX_API UPLMovementBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UPLMovementBenchmarkCommandlet();
+
+	/**
+	 * Runs the benchmark.
+	 * @param Params - The command line parameters of the commandlet.
+	 * @return 0 on success; 1 otherwise.
+	 */
+	virtual int32 Main(const FString &Params) override;
+
+private:
+	/**
+	 * Creates the world, in which the benchmark runs, with a floor, walls to slide on and a spline to move on.
+	 * @return The created and initialized world.
+	 */
+	UWorld *CreateBenchmarkWorld();
+
+	/**
+	 * Spawns a static cube mesh actor with blocking collision.
+	 * @param World - The world to spawn the actor in.
+	 * @param Location - The location of the actor.
+	 * @param Scale - The scale of the cube (unit cube is 100uu).
+	 * @param bWallSlidable - Whether the Wallslide trace channel is blocked by the actor.
+	 */
+	void SpawnBlockingCube(UWorld *World, const FVector &Location, const FVector &Scale, bool bWallSlidable);
+
+	/**
+	 * Applies the scripted input for the given frame to the given character.
+	 * @param Character - The character to control.
+	 * @param CharacterIndex - Index of the character (used to desync the input of the characters).
+	 * @param Frame - The current frame index.
+	 */
+	void ApplyScriptedInput(APLCharacter *Character, int32 CharacterIndex, int32 Frame) const;
+
+	/**
+	 * Returns the default pawn class of the global default GameMode (i.e. the character of the game), if it is an APLCharacter.
+	 * @return The character class; the native APLCharacter class if the GameMode has no APLCharacter as default pawn.
+	 */
+	static UClass *FindDefaultCharacterClass();
+
+	/**
+	 * Checks, whether the given character was given the abilities driven by the scripted input (Dash, Glide and WallSlide).
+	 * @param Character - The character to check.
+	 * @return True if all abilities were given; False otherwise.
+	 */
+	static bool HasScriptedAbilities(const APLCharacter &Character);
+
+	/** The spline the characters move on in the EPLMovementSpaceState::MovementOnSpline state. */
+	UPROPERTY()
+	USplineComponent *BenchmarkSpline;
+
+	/** Number of frames each EPLMovementSpaceState phase of the scripted input lasts. */
+	static constexpr int32 FramesPerMovementSpacePhase{180};
+};
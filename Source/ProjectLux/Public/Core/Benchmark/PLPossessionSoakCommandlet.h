@@ -0,0 +1,69 @@
+// Copyright TinyAlmonds (Alex Noerdemann)
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+#include "CoreMinimal.h"
+
+#include "PLPossessionSoakCommandlet.generated.h"
+
+// Forward declarations
+class AController;
+class ACharacter;
+class FJsonObject;
+class UAbilitySystemComponent;
+struct FPLAbilitySystemDelegateBindings;
+
+/**
+ * Soak test for the delegate bindings of the characters to their ASCs. Spawns an APLCharacter and an APLEnemyCharacterBase and possesses/unpossesses them repeatedly
+ * (like respawns or cutscenes do). The number of bindings and the invocation lists of the bound ASC delegates have to stay flat over all cycles.
+ * The counts after the first and the last cycle are written as JSON.
+ *
+ * Usage: UnrealEditor-Cmd ProjectLux.uproject -run=PLPossessionSoak -nullrhi -unattended [-Cycles=5000] [-Output=<FilePath>]
+ */
+UCLASS()
+class PROJECTLUX_API UPLPossessionSoakCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UPLPossessionSoakCommandlet();
+
+	/**
+	 * Runs the soak test.
+	 * @param Params - The command line parameters of the commandlet.
+	 * @return 0 if the bindings stayed flat and the result was written; 1 otherwise.
+	 */
+	virtual int32 Main(const FString &Params) override;
+
+private:
+	/** Number of bindings and allocated size of the invocation lists of the bound ASC delegates at one point of the soak. */
+	struct FBindingCounts
+	{
+		int32 NumBindings{0};
+		SIZE_T DelegateAllocatedSize{0};
+
+		bool operator==(const FBindingCounts &Other) const
+		{
+			return (NumBindings == Other.NumBindings) && (DelegateAllocatedSize == Other.DelegateAllocatedSize);
+		}
+	};
+
+	/**
+	 * Possesses and unpossesses the given character the given number of times.
+	 * @param Character - The character to soak.
+	 * @param AbilitySystemComponent - The ASC of the character.
+	 * @param Controller - The controller possessing the character.
+	 * @param Bindings - The delegate bindings of the character.
+	 * @param NumCycles - The number of possession cycles.
+	 * @return The JSON object holding the counts after the first and the last cycle and whether they are equal.
+	 */
+	static TSharedRef<FJsonObject> SoakPossession(ACharacter &Character, UAbilitySystemComponent &AbilitySystemComponent, AController &Controller, const FPLAbilitySystemDelegateBindings &Bindings, int32 NumCycles);
+
+	/**
+	 * Returns the current counts of the given character.
+	 * @param AbilitySystemComponent - The ASC of the character.
+	 * @param Bindings - The delegate bindings of the character.
+	 * @return The current counts.
+	 */
+	static FBindingCounts GetBindingCounts(UAbilitySystemComponent &AbilitySystemComponent, const FPLAbilitySystemDelegateBindings &Bindings);
+};
@@ -0,0 +1,180 @@
+// Copyright TinyAlmonds (Alex Noerdemann)
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/CharacterMovementComponent.h"
+
+#include "Core/Types/PLGravityScaleOverrideSource.h"
+#include "PLCharacterMovementComponent.generated.h"
+
+// Forward declarations
+class UPLAbilitySystemComponent;
+class UPLMovementAttributeSet;
+class USplineComponent;
+struct FPLSplineLookupTable;
+
+/**
+ * CharacterMovementComponent of the APLCharacter. Applies the terminal fall velocity of the UPLMovementAttributeSet while falling
+ * and manages the overrides of the GravityScale by abilities as a stack. Only the WallSlide is stacked until the Dash and Glide Blueprints are migrated, which still write
+ * the GravityScale directly (see EPLGravityScaleOverrideSource).
+ * If a movement spline is set, every move is constrained to the spline: The horizontal part of a move advances the distance along the spline, while the z-direction stays free.
+ * Landings are forwarded to the UPLAbilitySystemComponent of the owner, which releases the abilities blocked until the landing.
+ */
+UCLASS()
+class PROJECTLUX_API UPLCharacterMovementComponent : public UCharacterMovementComponent
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Computes the new velocity while falling and limits the negative z-velocity to the MaxFallSpeed attribute.
+	 * @param InitialVelocity - The velocity at the start of the simulation step.
+	 * @param Gravity - The gravity to apply.
+	 * @param DeltaTime - The duration of the simulation step.
+	 * @return The new velocity.
+	 */
+	virtual FVector NewFallVelocity(const FVector &InitialVelocity, const FVector &Gravity, float DeltaTime) const override;
+
+	/**
+	 * Overrides the GravityScale with the given value. The most recent override is active, until it is popped.
+	 * If the source already has an override, its previous override is replaced.
+	 * @param Source - The source of the override.
+	 * @param OverrideGravityScale - The GravityScale to apply.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Character|Movement")
+	void PushGravityScaleOverride(EPLGravityScaleOverrideSource Source, float OverrideGravityScale);
+
+	/**
+	 * Removes the override of the given source and applies the GravityScale of the remaining most recent override or the default GravityScale.
+	 * @param Source - The source of the override.
+	 * @param bApplyGravityScale - Whether the resulting GravityScale is applied. False keeps the current GravityScale, while an ability, which is not stacked yet, writes it directly
+	 * (e.g. the Dash).
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Character|Movement")
+	void PopGravityScaleOverride(EPLGravityScaleOverrideSource Source, bool bApplyGravityScale = true);
+
+	/** Removes all overrides and applies the default GravityScale (e.g. on respawn). */
+	UFUNCTION(BlueprintCallable, Category = "Character|Movement")
+	void ResetGravityScaleOverrides();
+
+	/**
+	 * Checks, whether the given source has an active override.
+	 * @param Source - The source to check.
+	 * @return True if the source overrides the GravityScale; False otherwise.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Character|Movement")
+	bool HasGravityScaleOverride(EPLGravityScaleOverrideSource Source) const;
+
+	/**
+	 * Returns the GravityScale, which is used when no override is active.
+	 * @return The default GravityScale.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Character|Movement")
+	float GetDefaultGravityScale() const;
+
+	/**
+	 * Sets the spline, which constrains the movement of the character in the XY plane. The character is not moved by this call.
+	 * @param Spline - The spline to move on. If nullptr, the movement is not constrained anymore.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Character|Movement")
+	void SetMovementSpline(const USplineComponent *Spline);
+
+	/**
+	 * Returns the direction of the movement spline (in the XY plane) at the current distance along the spline.
+	 * @return The normalized direction in world space; zero vector if no movement spline is set.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Character|Movement")
+	FVector GetMovementSplineDirection() const;
+
+	/**
+	 * Returns the distance along the movement spline, on which the character currently is.
+	 * @return The distance along the spline [uu].
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Character|Movement")
+	float GetMovementSplineDistance() const;
+
+	/** Called after the character was teleported. Resynchronizes the distance along the movement spline. */
+	virtual void OnTeleported() override;
+
+	/** Initializes the component and captures the default GravityScale. */
+	virtual void InitializeComponent() override;
+
+	/** The tick method called every frame. Timed as the CharacterMovement stage of the UPLHitchDetectorSubsystem. */
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction *ThisTickFunction) override;
+
+protected:
+	/** Method called when the game starts. */
+	virtual void BeginPlay() override;
+
+	/**
+	 * Moves the updated component. If a movement spline is set, the horizontal part of the delta is projected on the spline tangent
+	 * and the move ends on the spline, which replaces the correction of the location after the movement.
+	 * @param Delta - The requested move.
+	 * @param NewRotation - The new rotation of the updated component.
+	 * @param bSweep - Whether the move is swept.
+	 * @param OutHit - Optional result of the sweep.
+	 * @param Teleport - Whether the move is a teleport. Teleports are not constrained.
+	 * @return True if the component moved.
+	 */
+	virtual bool MoveUpdatedComponentImpl(const FVector &Delta, const FQuat &NewRotation, bool bSweep, FHitResult *OutHit = nullptr, ETeleportType Teleport = ETeleportType::None) override;
+
+	/**
+	 * Handles the landing after falling and notifies the UPLAbilitySystemComponent of the owner.
+	 * @param Hit - The hit of the landing.
+	 * @param RemainingTime - The remaining time of the simulation step.
+	 * @param Iterations - The current number of iterations of the simulation step.
+	 */
+	virtual void ProcessLanded(const FHitResult &Hit, float RemainingTime, int32 Iterations) override;
+
+private:
+	/** An override of the GravityScale. */
+	struct FPLGravityScaleOverride
+	{
+		EPLGravityScaleOverrideSource Source;
+		float GravityScale;
+	};
+
+	/** Applies the GravityScale of the most recent override or the default GravityScale. */
+	void ApplyGravityScaleOverrides();
+
+	/**
+	 * Sets the distance along the movement spline to the closest location of the updated component (in the XY plane).
+	 * @param bSearchAroundPreviousDistance - Whether a baked lookup table only searches around the previous distance (e.g. after a teleport on the same spline), instead of the whole spline.
+	 */
+	void SyncMovementSplineDistance(bool bSearchAroundPreviousDistance);
+
+	/**
+	 * Normalizes the given distance to the range of the movement spline (wrapped for closed loops; clamped otherwise).
+	 * @param Distance - The distance to normalize.
+	 * @return The normalized distance.
+	 */
+	float NormalizeMovementSplineDistance(float Distance) const;
+
+	/** The spline constraining the movement. Not constrained, if nullptr. */
+	UPROPERTY()
+	const USplineComponent *MovementSpline{nullptr};
+
+	/**
+	 * Returns the baked lookup table of the MovementSpline, if enabled. The table is resolved by the UPLSplineLookupSubsystem on every call,
+	 * since its owner (e.g. the APLPlayerStart) may register it after the spline was set or unregister it at any time.
+	 * @return The table; nullptr if the spline should be queried directly.
+	 */
+	const FPLSplineLookupTable *GetMovementSplineLookupTable() const;
+
+	/** The distance along the MovementSpline, on which the character currently is [uu]. */
+	float MovementSplineDistance{0.0f};
+
+	/** The UPLAbilitySystemComponent of the owning character. Cached on BeginPlay(). */
+	UPROPERTY()
+	UPLAbilitySystemComponent *AbilitySystemComponent{nullptr};
+
+	/** The movement related attributes of the owning character. Cached on BeginPlay(). */
+	UPROPERTY()
+	const UPLMovementAttributeSet *MovementAttributeSet{nullptr};
+
+	/** The GravityScale configured for the component (e.g. in the Blueprint class). Captured on InitializeComponent(). */
+	float DefaultGravityScale{1.0f};
+
+	/** Stack of the GravityScale overrides. The last element is the active override. */
+	TArray<FPLGravityScaleOverride, TInlineAllocator<3>> GravityScaleOverrides;
+};
@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 
 #include "Core/Component/ChaseActorAlongSpline/PLChaseActorAlongSplineSettings.h"
+#include "Core/Types/PLSplineLookupTable.h"
 #include "PLChaseActorAlongSplineComponent.generated.h"
 
 // Forward declarations
@@ -53,10 +54,22 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "")
 	void SetChaseActor(AActor *ActorToChase);
 
+	/** Resolves the chase spline (of the attach parent) and the reference spline again, e.g. after the owner was attached to another spline actor during play. */
+	UFUNCTION(BlueprintCallable, Category = "")
+	void RefreshSplines();
+
+#if WITH_EDITOR
+	/** Bakes the lookup tables of the chase spline (of the attach parent) and the reference spline, so that they are serialized with the level. */
+	virtual void PreSave(FObjectPreSaveContext ObjectSaveContext) override;
+#endif
+
 protected:
 	/** Method called when the game starts. */
 	virtual void BeginPlay() override;
 
+	/** Unregisters the baked lookup tables from the UPLSplineLookupSubsystem. */
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 private:
 	/** The settings of the chase. */
 	UPROPERTY(EditAnywhere, Category = "Config")
@@ -71,9 +84,96 @@ private:
 	/** The reference SplineComponent used for EPLChaseActorAlongSplineChaseMode::FollowPositionOnReferenceSpline. */
 	TWeakObjectPtr<USplineComponent> ReferenceSplineToFollow{};
 
+	/** Lookup table of the chase spline baked on save. */
+	UPROPERTY()
+	FPLSplineLookupTable ChaseSplineBakedLookupTable{};
+
+	/** Lookup table of the reference spline baked on save. */
+	UPROPERTY()
+	FPLSplineLookupTable ReferenceSplineBakedLookupTable{};
+
+	/** The valid lookup table of the chase spline (baked by this or another user of the spline). The spline is queried directly, if nullptr. */
+	const FPLSplineLookupTable *ChaseSplineLookupTable{nullptr};
+
+	/** The valid lookup table of the reference spline (baked by this or another user of the spline). The spline is queried directly, if nullptr. */
+	const FPLSplineLookupTable *ReferenceSplineLookupTable{nullptr};
+
+	/** Distance along the reference spline searched around the previous distance in addition to the movement of the chased actor [uu]. */
+	static constexpr float ReferenceSplineSearchDistance{200.0f};
+
+	/** Flag indicating whether ChaseSplineDistance and ReferenceSplineDistance hold the distances of the previous frame. */
+	bool bFollowDistancesValid{false};
+
+	/** The distance of the owner along the chase spline in the FollowPositionOnReferenceSpline state [uu]. */
+	float ChaseSplineDistance{0.0f};
+
+	/** The distance of the chased actor along the reference spline in the FollowPositionOnReferenceSpline state [uu]. */
+	float ReferenceSplineDistance{0.0f};
+
+	/** The location of the chased actor in the previous frame. */
+	FVector PreviousChasedActorLocation{FVector::ZeroVector};
+
+	/** Distances along the reference spline at the start of every segment and the spline length as last element [uu]. Built by RefreshSplines(). */
+	TArray<float> ReferenceSegmentDistances;
+
+	/** Distances along the chase spline at the start of every segment and the spline length as last element [uu]. Built by RefreshSplines(). */
+	TArray<float> ChaseSegmentDistances;
+
+	/**
+	 * Appends the distances along the given spline at the start of every segment and the spline length.
+	 * @param Spline - The spline.
+	 * @param OutSegmentDistances - The distances [uu].
+	 */
+	static void BuildSegmentDistances(const USplineComponent &Spline, TArray<float> &OutSegmentDistances);
+
+	/**
+	 * Maps the given distance along the reference spline to the chase spline. The segments of both splines correspond in their normalized order (like the normalized input keys),
+	 * while the position inside a segment is mapped by the arc length, so that the chase moves uniformly also along curved segments.
+	 * @param ReferenceDistance - The distance along the reference spline [uu].
+	 * @return The distance along the chase spline [uu].
+	 */
+	float MapReferenceToChaseDistance(float ReferenceDistance) const;
+
+	/** Unregisters the baked lookup tables from the UPLSplineLookupSubsystem. */
+	void UnregisterLookupTables();
+
+	/**
+	 * Returns the lookup table of the chase spline, if the tables are enabled.
+	 * @return The table; nullptr if the spline should be queried directly.
+	 */
+	const FPLSplineLookupTable *GetChaseSplineLookupTable() const;
+
+	/**
+	 * Returns the lookup table of the reference spline, if the tables are enabled.
+	 * @return The table; nullptr if the spline should be queried directly.
+	 */
+	const FPLSplineLookupTable *GetReferenceSplineLookupTable() const;
+
+	/**
+	 * Returns the distance along the reference spline closest to the chased actor. With a baked table, only the part around the previous distance is searched.
+	 * @param ChasedActorLocation - The location of the chased actor.
+	 * @return The distance along the reference spline [uu].
+	 */
+	float FindReferenceSplineDistance(const FVector &ChasedActorLocation);
+
+	/**
+	 * Returns the SplineComponent of the actor the owner is attached to.
+	 * @return The SplineComponent; nullptr if the owner is not attached to an actor with a spline.
+	 */
+	USplineComponent *FindChaseSpline() const;
+
+	/**
+	 * Returns the SplineComponent of the reference spline actor.
+	 * @return The SplineComponent; nullptr if no reference spline actor with a spline is set.
+	 */
+	USplineComponent *FindReferenceSpline() const;
+
 	/** Method used when the ChaseActorAlongSplineActorMode changed. */
 	void ActorModeChanged();
 
 	/** Method for setting the player as the chased actor. */
 	void SetChaseActorForPlayerActorMode();
+
+	/** Method for setting the local player nearest to the owner as the chased actor. */
+	void SetChaseActorForNearestPlayerActorMode();
 };
@@ -10,7 +10,9 @@ UENUM(BlueprintType)
 enum class EPLChaseActorAlongSplineActorMode : uint8
 {
 	Actor,
-	Player
+	Player,
+	/** The local player (e.g. of a splitscreen) nearest to the owner. */
+	NearestPlayer
 };
 
 /** Enumeration for the chasing mode of chasing actors along a spline. */
@@ -0,0 +1,120 @@
+// Copyright TinyAlmonds (Alex Noerdemann)
+#pragma once
+
+#include "Components/ActorComponent.h"
+#include "CoreMinimal.h"
+#include "GameplayEffectTypes.h"
+
+#include "PLMeleeHitComponent.generated.h"
+
+// Forward declarations
+class ACharacter;
+class UCapsuleComponent;
+class UGameplayEffect;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FPLOnMeleeHit, AActor *, HitActor, FVector, HitLocation);
+
+/**
+ * ActorComponent detecting the hits of melee attacks (e.g. the attack ability of the APLCharacter).
+ * On the start of a swing, the capsules of all potential targets around the owner are gathered once (broadphase). During the swing, the weapon sockets of the owner's mesh are swept
+ * as segments between the frames against these capsules. Every target is hit at most once per swing, so the damage effect spec of the swing carries the dynamic asset tag
+ * GameplayEffect.Damage.MeleeSwing, for which the UPLAttackDamageExecution skips the immunity effect.
+ * The damage effect spec is created once per swing and the hits of a frame are applied as batch.
+ */
+UCLASS(BlueprintType, Blueprintable, ClassGroup = (Custom), meta = (BlueprintSpawnableComponent))
+class PROJECTLUX_API UPLMeleeHitComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	/** Called for every target hit during a swing. */
+	UPROPERTY(BlueprintAssignable, Category = "Melee")
+	FPLOnMeleeHit OnMeleeHit;
+
+	/** Sets default values for this component's properties. */
+	UPLMeleeHitComponent();
+
+	/** The tick method called every frame during a swing. Sweeps the weapon sockets and applies the damage to new hits. */
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction *ThisTickFunction) override;
+
+	/**
+	 * Starts a swing (e.g. by an AnimNotifyState of the attack montage): Gathers the potential targets, clears the hits and creates the damage effect spec.
+	 * @param Level - The level of the damage effect.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Melee")
+	void BeginSwing(float Level = 1.0f);
+
+	/** Ends the current swing. */
+	UFUNCTION(BlueprintCallable, Category = "Melee")
+	void EndSwing();
+
+	/**
+	 * Checks, whether a swing is active.
+	 * @return True if a swing is active; False otherwise.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Melee")
+	bool IsSwinging() const;
+
+protected:
+	/** Sockets of the owner's mesh describing the weapon (e.g. hilt and tip). */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Melee")
+	TArray<FName> WeaponSockets;
+
+	/** Radius around the weapon sockets, which counts as hit [uu]. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Melee", meta = (ClampMin = "0.0"))
+	float WeaponRadius{10.0f};
+
+	/** Radius around the owner, in which potential targets are gathered on the start of a swing [uu]. Has to cover the reach of the weapon and the movement during the swing. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Melee", meta = (ClampMin = "0.0"))
+	float BroadphaseRadius{400.0f};
+
+	/** Class of the characters, which can be hit. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Melee")
+	TSubclassOf<ACharacter> TargetClass;
+
+	/** GameplayEffect applied to every hit target (e.g. using the UPLAttackDamageExecution). */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Melee")
+	TSubclassOf<UGameplayEffect> DamageEffect;
+
+private:
+	/** Number of targets and sockets, which are handled without a heap allocation. */
+	static constexpr int32 NumInlineElements{8};
+
+	/** Gathers the capsules of the potential targets around the owner. */
+	void GatherBroadphaseTargets();
+
+	/**
+	 * Sweeps the weapon from the previous to the current socket locations against the gathered capsules.
+	 * @param OutHitActors - The newly hit actors.
+	 * @param OutHitLocations - The hit locations (same order as OutHitActors).
+	 */
+	void SweepWeapon(TArray<AActor *, TInlineAllocator<NumInlineElements>> &OutHitActors, TArray<FVector, TInlineAllocator<NumInlineElements>> &OutHitLocations);
+
+	/**
+	 * Applies the damage effect spec of the swing to the given actors.
+	 * @param HitActors - The hit actors.
+	 */
+	void ApplyDamage(const TArray<AActor *, TInlineAllocator<NumInlineElements>> &HitActors) const;
+
+	/**
+	 * Stores the current world locations of the weapon sockets.
+	 * @param OutSocketLocations - The socket locations (same order as WeaponSockets).
+	 * @return True if the owner has a mesh; False otherwise.
+	 */
+	bool GetSocketLocations(TArray<FVector, TInlineAllocator<NumInlineElements>> &OutSocketLocations) const;
+
+	/** The capsules of the potential targets of the current swing. */
+	TArray<TWeakObjectPtr<UCapsuleComponent>, TInlineAllocator<NumInlineElements>> BroadphaseTargets;
+
+	/** The actors hit in the current swing. */
+	TArray<TWeakObjectPtr<AActor>, TInlineAllocator<NumInlineElements>> HitActorsOfSwing;
+
+	/** The socket locations of the previous frame. */
+	TArray<FVector, TInlineAllocator<NumInlineElements>> PreviousSocketLocations;
+
+	/** The damage effect spec of the current swing. */
+	FGameplayEffectSpecHandle DamageEffectSpecHandle;
+
+	/** Flag indicating whether a swing is active. */
+	bool bSwinging{false};
+};
@@ -7,6 +7,10 @@
 #include "Core/Component/TrackActor/PLTrackActorSettings.h"
 #include "PLTrackActorComponent.generated.h"
 
+// Forward declarations
+class UMeshComponent;
+class USceneComponent;
+
 /**
  * ActorComponent class to track actors or the player actor.
  */
@@ -50,6 +54,13 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "")
 	void SetTrackActor(AActor *ActorToTrack);
 
+	/**
+	 * Returns the current world rotation of the tracking (e.g. for the animation in the EPLTrackActorRotationTarget::Parameter state).
+	 * @return The rotation of the tracking.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "")
+	FRotator GetTrackRotation() const;
+
 protected:
 	/** Method called when the game starts. */
 	virtual void BeginPlay() override;
@@ -62,9 +73,33 @@ private:
 	/** The previously used TrackMode. */
 	EPLTrackActorMode PreviousTrackMode{EPLTrackActorMode::Actor};
 
+	/** The rotated scene component in the EPLTrackActorRotationTarget::SceneComponent state. */
+	TWeakObjectPtr<USceneComponent> RotatedComponent{};
+
+	/** The meshes of the owner receiving the material parameters in the EPLTrackActorRotationTarget::Parameter state. */
+	TArray<TWeakObjectPtr<UMeshComponent>> ParameterMeshComponents{};
+
+	/** The last applied world rotation of the tracking. Only read in the EPLTrackActorRotationTarget::Parameter state, since the rotation of an actor or scene component is read back from it. */
+	FRotator TrackRotation{FRotator::ZeroRotator};
+
+	/**
+	 * Returns the world location from which the tracked actor is looked at.
+	 * @return The location of the rotated component or the owner.
+	 */
+	FVector GetTrackLocation() const;
+
+	/**
+	 * Applies the given rotation to the RotationTarget.
+	 * @param Rotation - The world rotation to apply.
+	 */
+	void ApplyTrackRotation(const FRotator &Rotation);
+
 	/** Method used when the TrackMode changed. */
 	void TrackModeChanged();
 
 	/** Method for setting the player as the tracked actor. */
 	void SetTrackActorForPlayerTrackMode();
+
+	/** Method for setting the local player nearest to the owner as the tracked actor. */
+	void SetTrackActorForNearestPlayerTrackMode();
 };
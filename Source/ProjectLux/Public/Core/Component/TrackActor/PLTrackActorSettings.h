@@ -10,7 +10,21 @@ UENUM(BlueprintType)
 enum class EPLTrackActorMode : uint8
 {
 	Actor,
-	Player
+	Player,
+	/** The local player (e.g. of a splitscreen) nearest to the owner. */
+	NearestPlayer
+};
+
+/** Enumeration for what is rotated by the tracking. */
+UENUM(BlueprintType)
+enum class EPLTrackActorRotationTarget : uint8
+{
+	/** The whole owner actor is rotated. */
+	Actor,
+	/** Only a scene component of the owner (e.g. a turret head) is rotated, so that the transform of the remaining hierarchy stays untouched. */
+	SceneComponent,
+	/** Nothing is moved. The rotation is passed to scalar material parameters and can be read by the animation (GetTrackRotation()). */
+	Parameter
 };
 
 /** Struct holding information about tracking an actor. */
@@ -30,4 +44,24 @@ struct FPLTrackActorSet
 	/**	The rotation rate indicating how fast the actor should be tracked (similar to lag). */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Config", meta = (ClampMin = "0.0", UIMin = "0.0"))
 	float RotationRate{0.0F};
+
+	/**	What is rotated by the tracking. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Config")
+	EPLTrackActorRotationTarget RotationTarget{EPLTrackActorRotationTarget::Actor};
+
+	/**	The name of the scene component of the owner, which is rotated. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Config", meta = (EditCondition = "RotationTarget == EPLTrackActorRotationTarget::SceneComponent", EditConditionHides))
+	FName RotatedComponentName{NAME_None};
+
+	/**	The name of the scalar material parameter of the owner's meshes receiving the yaw [deg]. Not set, if none. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Config", meta = (EditCondition = "RotationTarget == EPLTrackActorRotationTarget::Parameter", EditConditionHides))
+	FName YawParameterName{NAME_None};
+
+	/**	The name of the scalar material parameter of the owner's meshes receiving the pitch [deg]. Not set, if none. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Config", meta = (EditCondition = "RotationTarget == EPLTrackActorRotationTarget::Parameter", EditConditionHides))
+	FName PitchParameterName{NAME_None};
+
+	/**	The remaining error of the rotation per axis, below which the tracking counts as settled [deg]. A settled tracking does not update anything. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Config", meta = (ClampMin = "0.0", UIMin = "0.0"))
+	float RotationDeadZone{0.1F};
 };
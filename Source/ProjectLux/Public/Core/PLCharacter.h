@@ -4,17 +4,24 @@
 #include "AbilitySystemInterface.h"
 #include "CoreMinimal.h"
 #include "GameFramework/Character.h"
+#include "GameplayAbilitySpec.h"
 #include "GameplayTagContainer.h"
 
-#include "Types/PLMovementSpaceState.h"
+#include "AbilitySystem/PLAbilitySystemDelegateBindings.h"
+#include "AbilitySystem/PLAttributeSnapshot.h"
+#include "Types/PLMovementSpaceProfile.h"
 #include "PLCharacter.generated.h"
 
 // Forward declarations
+class UAbilitySystemComponent;
 class UGameplayAbility;
 class UGameplayEffect;
-class UAbilitySystemComponent;
+class UPLAbilitySet;
+class UPLAbilitySystemComponent;
 class UPLCharacterAttributeSet;
 class UPLMovementAttributeSet;
+class UPLCharacterMovementComponent;
+class UPLMeleeHitComponent;
 struct FOnAttributeChangeData;
 template <typename OptionalType>
 struct TOptional;
@@ -30,24 +37,34 @@ class PROJECTLUX_API APLCharacter : public ACharacter, public IAbilitySystemInte
 	GENERATED_BODY()
 
 public:
-	/** Default GameplayAbilities for this character. These will be removed and added again on character possession. */
+	/** Sets of the GameplayAbilities and initialization GameplayEffects of this character (e.g. movement and combat). These will be removed and given again on character possession. */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Character|Abilities")
+	TArray<UPLAbilitySet *> AbilitySets;
+
+	/** Deprecated default GameplayAbilities. Moved into an entry of the AbilitySets on load. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Character|Abilities|Deprecated", meta = (DeprecatedProperty, DeprecationMessage = "Use AbilitySets instead."))
 	TArray<TSubclassOf<UGameplayAbility>> DefaultAbilities;
 
-	/** Default passive GameplayAbilities for this character. These will be removed and added again on character possession. */
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Character|Abilities")
+	/** Deprecated default passive GameplayAbilities. Moved into an entry of the AbilitySets on load. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Character|Abilities|Deprecated", meta = (DeprecatedProperty, DeprecationMessage = "Use AbilitySets instead."))
 	TArray<TSubclassOf<UGameplayAbility>> DefaultPassiveAbilities;
 
-	/** GameplayEffect which is used to initialize the AttributeSet of the character. */
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Character|Abilities")
+	/** Deprecated GameplayEffect initializing the AttributeSet. Moved into an entry of the AbilitySets on load. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Character|Abilities|Deprecated", meta = (DeprecatedProperty, DeprecationMessage = "Use AbilitySets instead."))
 	TSubclassOf<UGameplayEffect> AttributeSetInitEffect;
 
-	/** GameplayEffect which is used to initialize the movement related AttributeSet of the character. */
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Character|Abilities")
+	/** Deprecated GameplayEffect initializing the movement related AttributeSet. Moved into an entry of the AbilitySets on load. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Character|Abilities|Deprecated", meta = (DeprecatedProperty, DeprecationMessage = "Use AbilitySets instead."))
 	TSubclassOf<UGameplayEffect> MovementAttributeSetInitEffect;
 
-	/** Sets default values for this character's properties */
-	APLCharacter();
+	/**
+	 * Sets default values for this character's properties.
+	 * @param ObjectInitializer - Initializer used to replace the CharacterMovementComponent by the UPLCharacterMovementComponent.
+	 */
+	APLCharacter(const FObjectInitializer &ObjectInitializer);
+
+	/** Moves the deprecated default abilities and initialization effects into an entry of the AbilitySets. */
+	virtual void PostLoad() override;
 
 	/** Called every frame */
 	virtual void Tick(float DeltaTime) override;
@@ -62,6 +79,22 @@ public:
 	/** Runs logic when this Character is possessed. */
 	virtual void PossessedBy(AController *NewController) override;
 
+	/** Removes the bindings to the ASC delegates made on possession. */
+	virtual void UnPossessed() override;
+
+	/**
+	 * Returns the bindings to the ASC delegates (e.g. to check that repeated possessions do not pile them up).
+	 * @return The bindings to the ASC delegates.
+	 */
+	const FPLAbilitySystemDelegateBindings &GetAbilitySystemDelegateBindings() const;
+
+	/**
+	 * Returns the UPLCharacterMovementComponent of the Character.
+	 * @return The UPLCharacterMovementComponent. Has to be checked for validness.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Character|Movement")
+	UPLCharacterMovementComponent *GetPLCharacterMovement() const;
+
 	/** Performs a wall jump when the Character is wall sliding otherwise a jump until the jump button is released or exceeds the max hold time. */
 	UFUNCTION(BlueprintCallable, Category = "Character|Movement")
 	virtual void JumpPress();
@@ -133,6 +166,22 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Character|Movement")
 	virtual void SetMovementSpaceState(EPLMovementSpaceState State);
 
+	/**
+	 * Applies the given movement space transition at once: The state, the spline, the movement constraints of the state profile and the camera (blended with the settings of the profile).
+	 * The Blueprint event of the MovementSpaceState change is called once, if the state changed.
+	 * @param Transition - The transition to apply.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Character|Movement")
+	virtual void ApplyMovementSpaceTransition(const FPLMovementSpaceTransition &Transition);
+
+	/**
+	 * Requests the given movement space transition, which is applied after the MovementSpaceTransitionDebounceTime without a new request.
+	 * Repeated requests (e.g. of overlapping trigger volumes) are coalesced to the last one, which is dropped if it matches the current movement space.
+	 * @param Transition - The transition to request.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Character|Movement")
+	virtual void RequestMovementSpaceTransition(const FPLMovementSpaceTransition &Transition);
+
 	/**
 	 * Returns the previous value of the movement space state.
 	 * @return The previous value of the movement space state member.
@@ -165,6 +214,23 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Character|Combat")
 	virtual void DeactivateAttackAbilityCombo();
 
+	/**
+	 * Resets the Character for a respawn without a new possession: Ends all abilities, removes the death and cooldown states,
+	 * restores the attributes captured after the initialization on possession, applies the movement space transition and teleports the Character.
+	 * @param SpawnTransform - The transform to respawn at.
+	 * @param SpawnTransition - The movement space transition of the spawn (e.g. of the APLPlayerStart).
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Character")
+	virtual void Respawn(const FTransform &SpawnTransform, const FPLMovementSpaceTransition &SpawnTransition);
+
+	/**
+	 * Teleports the Character to the given spawn and applies the movement space transition of the spawn.
+	 * @param SpawnTransform - The transform to teleport to.
+	 * @param SpawnTransition - The movement space transition of the spawn (e.g. of the APLPlayerStart).
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Character|Movement")
+	virtual void TeleportToSpawn(const FTransform &SpawnTransform, const FPLMovementSpaceTransition &SpawnTransition);
+
 	/** Checks if the Character is dead.
 	 * @return True if the Character is dead; False otherwise.
 	 */
@@ -175,6 +241,9 @@ protected:
 	/** Called when the game starts or when spawned. */
 	virtual void BeginPlay() override;
 
+	/** Removes the bindings to the ASC delegates. */
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	/** Determines if the Character should wall slide and sets the related flag. This method is called on every Tick. */
 	virtual void UpdateWallSlidingFlag();
 
@@ -187,9 +256,25 @@ protected:
 	/** Called, when SetWallSlidingFlag() was called. Tries to activate the WallSlide ability if wall slide flag is True; else the ability is canceled.*/
 	virtual void OnWallSlidingFlagSet();
 
-	/** Reduces/extends the space in which the Character can move.*/
+	/**
+	 * Checks, whether the Character is already in the movement space of the given transition.
+	 * @param Transition - The transition to check.
+	 * @return True if applying the transition would not change anything; False otherwise.
+	 */
+	bool IsMovementSpaceTransitionApplied(const FPLMovementSpaceTransition &Transition) const;
+
+	/** Reduces/extends the space in which the Character can move by applying the FPLMovementSpaceProfile of the movement space state. */
 	virtual void OnMovementSpaceStateChanged();
 
+	/** Constrains the movement of the UPLCharacterMovementComponent to the movement spline, if the FPLMovementSpaceProfile of the movement space state requires it; else the constraint is removed. */
+	void UpdateMovementSplineConstraint();
+
+	/**
+	 * Returns the direction of the movement spline at the location of the Character.
+	 * @return The normalized direction in the XY plane; zero vector if the Character does not move on a spline.
+	 */
+	FVector GetMovementSplineDirection() const;
+
 	/** Event for the Blueprint class to react on MovementSpaceState changes.*/
 	UFUNCTION(BlueprintImplementableEvent, Category = "Character|Movement", DisplayName = "On MovementSpaceState Changed")
 	void MovementSpaceStateChanged();
@@ -218,6 +303,10 @@ protected:
 	UFUNCTION(BlueprintImplementableEvent, Category = "Character", DisplayName = "On Died")
 	void Died();
 
+	/** Event for the Blueprint class to react to the respawn of the character (e.g. to reset the death visuals).*/
+	UFUNCTION(BlueprintImplementableEvent, Category = "Character", DisplayName = "On Respawned")
+	void Respawned();
+
 	/**
 	 * Checks, whether the Character touches a wall for the wall slide.
 	 * @return An TOptional with the FHitResult of the wall when the Character faces and touches the wall, and is currently falling. Otherwise an empty TOptional.
@@ -242,15 +331,9 @@ protected:
 	 */
 	virtual void TryRotateAwayFromWall(FRotator3d const &RotationFromInput);
 
-	/**
-	 * Member holds the default value of the CharacterMovementComponent's GravityScale
-	 * @note This is a little flaw in the class design, since this value has to kept in sync with the constant default value in the related Blueprint class.
-	 */
-	static constexpr float DefaultCharacterMovementComponentGravityScale{5.5f};
-
 	/** The AbilitySystemComponent of this Actor. */
 	UPROPERTY()
-	UAbilitySystemComponent *AbilitySystemComponent;
+	UPLAbilitySystemComponent *AbilitySystemComponent;
 
 	/** List of attributes modified by the ability system */
 	UPROPERTY()
@@ -260,6 +343,19 @@ protected:
 	UPROPERTY()
 	UPLMovementAttributeSet *MovementAttributeSet;
 
+	/** The hit detection of the attack ability. The swings are started and ended by the attack montage. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Character|Combat")
+	UPLMeleeHitComponent *MeleeHitComponent;
+
+	/** Base values of the attributes after the initialization on possession. Restored on respawn. */
+	FPLAttributeSnapshot SpawnAttributeSnapshot;
+
+	/** Handles of the passive abilities given on possession. Activated again on respawn. */
+	TArray<FGameplayAbilitySpecHandle> PassiveAbilitySpecHandles;
+
+	/** Bindings to the attribute and GameplayTag delegates of the ASC made on possession. Removed on unpossession and at the end of play. */
+	FPLAbilitySystemDelegateBindings AbilitySystemDelegateBindings;
+
 	/** Member holding the last set value of the MoveUp axis mapping. */
 	UPROPERTY(BlueprintReadOnly, Category = "Character|Movement")
 	float AxisValueMoveUp{};
@@ -281,40 +377,27 @@ protected:
 	/** Member indicating the space the Character was able to move in before the change. */
 	EPLMovementSpaceState PreviousMovementSpace;
 
-	/** Reference to an USplineComponent in the world on which the Character moves, if she is in the EPLMovementSpaceState::MovementOnSpline state. */
-	UPROPERTY()
-	USplineComponent const *MovementSplineComponentFromWorld;
-
-	/** Member holding the tag which describes the Sprint ability. */
-	FGameplayTag SprintAbilityTag;
-
-	/** Member holding the tag which describes the Wall Slide ability. */
-	FGameplayTag WallSlideAbilityTag;
+	/** Time a requested movement space transition has to be stable (i.e. without a new request), until it is applied [s]. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Character|Movement")
+	float MovementSpaceTransitionDebounceTime{0.1f};
 
-	/** Member holding the tag which describes the Wall Jump ability. */
-	FGameplayTag WallJumpAbilityTag;
-
-	/** Member holding the tag which describes the Dash ability. */
-	FGameplayTag DashAbilityTag;
-
-	/** Member holding the tag which describes the Double-Dash ability. */
-	FGameplayTag DoubleDashAbilityTag;
+	/** The last requested movement space transition, which is not applied yet. */
+	UPROPERTY()
+	FPLMovementSpaceTransition PendingMovementSpaceTransition{};
 
-	/** Member holding the tag which describes the QuickStep ability. */
-	FGameplayTag QuickStepAbilityTag;
+	/** Flag indicating whether the PendingMovementSpaceTransition has to be applied. */
+	bool bMovementSpaceTransitionPending{false};
 
-	/** Member holding the tag which describes the Glide ability. */
-	FGameplayTag GlideAbilityTag;
+	/** World time of the last movement space transition request [s]. */
+	double MovementSpaceTransitionRequestTime{0.0};
 
-	/** Member holding the tag which describes the Attack ability. */
-	FGameplayTag AttackAbilityTag;
+	/** Reference to an USplineComponent in the world on which the Character moves, if she is in the EPLMovementSpaceState::MovementOnSpline state. */
+	UPROPERTY()
+	USplineComponent const *MovementSplineComponentFromWorld;
 
 	/** Member holding the tags of abilities blocking the MoveRight-/Up input. */
 	FGameplayTagContainer MoveBlockingAbilityTags;
 
-	/** Member holding the tag which describes the death of the character. */
-	FGameplayTag DeadTag;
-
 	/** Flag indicating whether the AnimMontage of the attack ability is in a combo interval/window. If so the flag is True; otherwise False.*/
 	bool bAttackAbilityComboEnabled;
 
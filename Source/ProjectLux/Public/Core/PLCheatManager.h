@@ -1,6 +1,7 @@
 // Copyright TinyAlmonds (Alex Noerdemann)
 #pragma once
 
+#include "Containers/Ticker.h"
 #include "CoreMinimal.h"
 
 #include "BUICheatManagerBase.h"
@@ -8,6 +9,7 @@
 
 /**
  * Custom CheatManager class of the project (e.g. for custom console commands).
+ * The stress test commands print a summary of the frame times of the following frames, so that the scaling and the fast paths can be measured on real maps.
  */
 UCLASS(meta = (CheatPrefix = "projectlux."))
 class PROJECTLUX_API UPLCheatManager : public UBUICheatManagerBase
@@ -15,17 +17,141 @@ class PROJECTLUX_API UPLCheatManager : public UBUICheatManagerBase
 	GENERATED_BODY()
 
 public:
+	/** Prefix of the console variables toggling the fast paths (e.g. "projectlux.FastPath.SplineLookupTables"). */
+	static const FString FastPathPrefix;
+
+	/** Number of frames summarized after a stress test command, if not given. */
+	static constexpr int32 DefaultNumSummaryFrames{120};
+
+	/** Distance between two enemies of the SpawnEnemyGrid, if not given [uu]. */
+	static constexpr float DefaultGridSpacing{300.0f};
+
+	/** Frame time above which a frame counts as a hitch in the summary [ms]. */
+	static constexpr float HitchFrameTime{33.3f};
+
+	/** Number of the slowest frames printed by InspectHitchDump. */
+	static constexpr int32 NumInspectedSlowestFrames{5};
+
 	/**
 	 * Teleports the player to the specified PlayerStart.
 	 * @param PlayerStartTag - The tag of the PlayerStart the player should be teleported.
-	 * @note If the tag is not given or "None", the player will be teleported to the last Checkpoint/PlayerStart of the MainSaveGame.
+	 * @note If the tag is not given or "None", the native implementation teleports the player to the PlayerStart used on the last spawn.
 	 */
 	UFUNCTION(exec, BlueprintNativeEvent, meta = (Cheat = "TeleportToPlayerStart"))
 	void TeleportToPlayerStart(FName PlayerStartTag);
 
 	/**
-	 * Implementation for the Native Event TeleportToPlayerStart(). Does nothing for now, since we expect an implementation in Blueprint.
+	 * Implementation for the Native Event TeleportToPlayerStart(). Looks up the PlayerStart in the UPLPlayerStartSubsystem.
 	 * @param PlayerStartTag - The tag of the PlayerStart the player should be teleported.
 	 */
 	virtual void TeleportToPlayerStart_Implementation(FName PlayerStartTag);
+
+	/**
+	 * Spawns enemies in a grid around the player. The enemies get their default controller.
+	 * @param EnemyClassName - The name (e.g. "BP_Enemy_C") or object path of an APLEnemyCharacterBase class.
+	 * @param Count - The number of enemies to spawn.
+	 * @param Spacing - The distance between two enemies of the grid [uu]. 300 if not given.
+	 */
+	UFUNCTION(exec, meta = (Cheat = "SpawnEnemyGrid"))
+	void SpawnEnemyGrid(const FString &EnemyClassName, int32 Count, float Spacing);
+
+	/**
+	 * Spawns actors (e.g. with a UPLTrackActorComponent or UPLChaseActorAlongSplineComponent) in equal distances along a spline and attaches them to the spline actor.
+	 * @param ActorClassName - The name (e.g. "BP_Chaser_C") or object path of an actor class.
+	 * @param SplineActorName - The tag or name of the actor owning the spline.
+	 * @param Count - The number of actors to spawn.
+	 */
+	UFUNCTION(exec, meta = (Cheat = "SpawnOnSpline"))
+	void SpawnOnSpline(const FString &ActorClassName, FName SplineActorName, int32 Count);
+
+	/** Destroys all actors spawned by the stress test commands. */
+	UFUNCTION(exec, meta = (Cheat = "DestroyStressActors"))
+	void DestroyStressActors();
+
+	/**
+	 * Enables or disables a fast path at runtime, so that it can be compared with the regular path without rebuilding.
+	 * @param FastPathName - The name of the fast path without the prefix (e.g. "SplineLookupTables"). Lists all fast paths, if unknown.
+	 * @param bEnabled - Whether the fast path should be used.
+	 */
+	UFUNCTION(exec, meta = (Cheat = "SetFastPath"))
+	void SetFastPath(const FString &FastPathName, bool bEnabled);
+
+	/** Lists all fast paths with their current state. */
+	UFUNCTION(exec, meta = (Cheat = "ListFastPaths"))
+	void ListFastPaths();
+
+	/**
+	 * Prints a summary of the frame times of the following frames.
+	 * @param NumFrames - The number of summarized frames. DefaultNumSummaryFrames if not given.
+	 */
+	UFUNCTION(exec, meta = (Cheat = "FrameTimeSummary"))
+	void FrameTimeSummary(int32 NumFrames);
+
+	/**
+	 * Prints the hitch frame, the stage times and the slowest frames of a dump of the UPLHitchDetectorSubsystem.
+	 * @param DumpFileName - The name or path of the dump file. The latest dump is used, if not given.
+	 */
+	UFUNCTION(exec, meta = (Cheat = "InspectHitchDump"))
+	void InspectHitchDump(const FString &DumpFileName);
+
+	/**
+	 * Prints the memory footprint of the player characters, the enemies (in total and per enemy class) and the caches of the project (see FPLMemoryReport).
+	 * The allocations of the project are additionally tracked by the ProjectLux tags of the low level memory tracker ("stat LLMFULL", when running with -llm).
+	 */
+	UFUNCTION(exec, meta = (Cheat = "MemoryReport"))
+	void MemoryReport();
+
+	/** Stops the sampling of the frame times. */
+	virtual void BeginDestroy() override;
+
+private:
+	/**
+	 * Finds the actor class of the given name or object path.
+	 * @param ClassName - The name (e.g. "BP_Enemy_C") or object path of the class.
+	 * @param BaseClass - The class the found class has to derive from.
+	 * @return The non-abstract class; nullptr if not found.
+	 */
+	static UClass *FindActorClass(const FString &ClassName, const UClass *BaseClass);
+
+	/**
+	 * Starts sampling the frame times of the following frames. A running sampling is replaced.
+	 * @param Label - The label of the printed summary (e.g. the command).
+	 * @param NumFrames - The number of summarized frames.
+	 */
+	void StartFrameTimeSummary(const FString &Label, int32 NumFrames = DefaultNumSummaryFrames);
+
+	/**
+	 * Samples the time of the current frame and prints the summary, when all frames are sampled.
+	 * @param DeltaTime - The time of the frame [s].
+	 * @return True if the sampling continues; False if it is done.
+	 */
+	bool SampleFrameTime(float DeltaTime);
+
+	/** Prints the summary of the sampled frame times and stops the sampling. */
+	void PrintFrameTimeSummary();
+
+	/**
+	 * Prints the given message on the screen and into the log.
+	 * @param Message - The message to print.
+	 * @param Color - The color on the screen.
+	 */
+	static void PrintMessage(const FString &Message, const FColor &Color = FColor::Cyan);
+
+	/** The actors spawned by the stress test commands. */
+	TArray<TWeakObjectPtr<AActor>> StressActors;
+
+	/** The label of the running frame time summary. */
+	FString FrameTimeLabel;
+
+	/** The number of frames of the running frame time summary. */
+	int32 NumFrameTimeFrames{0};
+
+	/** The sampled frame times [ms]. */
+	TArray<float> FrameTimes;
+
+	/** The sampled game thread times [ms]. */
+	TArray<float> GameThreadTimes;
+
+	/** Handle of the ticker sampling the frame times. */
+	FTSTicker::FDelegateHandle FrameTimeTickerHandle;
 };
@@ -6,14 +6,17 @@
 #include "GameFramework/Character.h"
 #include "GameplayTagContainer.h"
 
+#include "AbilitySystem/PLAbilitySystemDelegateBindings.h"
 #include "PLEnemyCharacterBase.generated.h"
 
 // Forward declarations
 struct FOnAttributeChangeData;
-class UPLAbilitySystemComponent;
 class UGameplayAbility;
 class UGameplayEffect;
+class UPLAbilitySet;
+class UPLAbilitySystemComponent;
 class UPLCharacterAttributeSet;
+struct FStreamableHandle;
 
 UCLASS()
 class PROJECTLUX_API APLEnemyCharacterBase : public ACharacter, public IAbilitySystemInterface
@@ -24,16 +27,20 @@ public:
 	// Sets default values for this character's properties
 	APLEnemyCharacterBase();
 
-	/** GameplayEffect which is used to initialize the AttributeSet of the character. */
+	/** Sets of the GameplayAbilities and initialization GameplayEffects of this character (e.g. the enemy archetype). These will be given on character possession. */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Character|Abilities")
+	TArray<UPLAbilitySet *> AbilitySets;
+
+	/** Deprecated GameplayEffect initializing the AttributeSet. Moved into an entry of the AbilitySets on load. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Character|Abilities|Deprecated", meta = (DeprecatedProperty, DeprecationMessage = "Use AbilitySets instead."))
 	TSubclassOf<UGameplayEffect> AttributeSetInitEffect;
 
-	/** Default GameplayAbilities for this character. These will be added on character possession. */
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Character|Abilities")
+	/** Deprecated default GameplayAbilities. Moved into an entry of the AbilitySets on load. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Character|Abilities|Deprecated", meta = (DeprecatedProperty, DeprecationMessage = "Use AbilitySets instead."))
 	TArray<TSubclassOf<UGameplayAbility>> DefaultAbilities;
 
-	// Called every frame
-	virtual void Tick(float DeltaTime) override;
+	/** Moves the deprecated default abilities and initialization effect into an entry of the AbilitySets. */
+	virtual void PostLoad() override;
 
 	/**
 	 * Returns the AbilitySystemComponent (ASC) of this Actor.
@@ -45,10 +52,25 @@ public:
 	/** Runs logic when this Character is possessed. */
 	virtual void PossessedBy(AController *NewController) override;
 
+	/** Cancels a pending load of the ability sets and removes the bindings to the ASC delegates. */
+	virtual void UnPossessed() override;
+
+	/**
+	 * Returns the bindings to the ASC delegates (e.g. to check that repeated possessions do not pile them up).
+	 * @return The bindings to the ASC delegates.
+	 */
+	const FPLAbilitySystemDelegateBindings &GetAbilitySystemDelegateBindings() const;
+
 protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 
+	/** Unregisters the enemy from the UPLEnemyDirectorSubsystem and removes the bindings to the ASC delegates. */
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/** Gives the ability sets to the ASC and binds the delegates to attribute and GameplayTag changes. Called, when the ability sets are loaded. */
+	virtual void InitializeAbilitySystem();
+
 	/** Reacts to Health attribute changes and calls the Blueprint event.*/
 	virtual void OnHealthChanged(FOnAttributeChangeData const &Data);
 
@@ -87,6 +109,9 @@ protected:
 	UPROPERTY()
 	UPLCharacterAttributeSet *AttributeSet;
 
-	/** Member holding the tag which describes the death of the character. */
-	FGameplayTag DeadTag;
+	/** Handle of the asynchronous load of the ability sets, which keeps the loaded classes referenced. */
+	TSharedPtr<FStreamableHandle> AbilitySetsLoadHandle;
+
+	/** Bindings to the attribute and GameplayTag delegates of the ASC made after the possession. */
+	FPLAbilitySystemDelegateBindings AbilitySystemDelegateBindings;
 };
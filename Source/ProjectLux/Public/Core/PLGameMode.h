@@ -6,6 +6,10 @@
 
 #include "PLGameMode.generated.h"
 
+// Forward declarations
+class UPLAbilitySet;
+struct FStreamableHandle;
+
 /**
  * Custom GameMode class for the project.
  */
@@ -13,4 +17,46 @@ UCLASS()
 class PROJECTLUX_API APLGameMode : public AGameModeBase
 {
 	GENERATED_BODY()
+
+public:
+	/** Ability sets, which are loaded asynchronously with the map in addition to the ability sets of the DefaultPawnClass (e.g. the enemy archetypes of the map). */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "GameMode|Abilities")
+	TArray<UPLAbilitySet *> PreloadedAbilitySets;
+
+	/** Starts the asynchronous load of the ability sets, so that they are loaded ahead of the possession of the pawns. */
+	virtual void InitGame(const FString &MapName, const FString &Options, FString &ErrorMessage) override;
+
+	/**
+	 * Returns whether the given player can be restarted. Players are not restarted, until the preloaded ability sets are loaded.
+	 * @param Player - The controller of the player.
+	 * @return True if the player can be restarted; False otherwise.
+	 */
+	virtual bool PlayerCanRestart_Implementation(APlayerController *Player) override;
+
+	/**
+	 * Respawns the player at its last PlayerStart (e.g. a checkpoint). An existing APLCharacter is reused: Its attributes are restored
+	 * and the movement space transition of the APLPlayerStart is applied, instead of spawning and possessing a new pawn.
+	 * @param Player - The controller of the player to respawn.
+	 * @return True if the existing character was reused; False if the player was restarted with a new pawn.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "GameMode|Respawn")
+	virtual bool RespawnPlayer(AController *Player);
+
+	/**
+	 * Returns the PlayerStart for the given player. PlayerStarts requested by tag are looked up in the UPLPlayerStartSubsystem instead of iterating all PlayerStarts.
+	 * @param Player - The controller of the player.
+	 * @param IncomingName - The tag of the requested PlayerStart. If empty, the default choice is used.
+	 * @return The chosen PlayerStart.
+	 */
+	virtual AActor *FindPlayerStart_Implementation(AController *Player, const FString &IncomingName) override;
+
+protected:
+	/** Restarts the players, which were waiting for the preloaded ability sets. */
+	virtual void OnAbilitySetsPreloaded();
+
+	/** Handle of the asynchronous load of the ability sets, which keeps the loaded classes referenced. */
+	TSharedPtr<FStreamableHandle> AbilitySetsPreloadHandle;
+
+	/** Flag indicating whether the preloaded ability sets are loaded. */
+	bool bAbilitySetsPreloaded{false};
 };
@@ -6,7 +6,8 @@
 #include "CoreMinimal.h"
 #include "GameFramework/PlayerStart.h"
 
-#include "Types/PLMovementSpaceState.h"
+#include "Types/PLMovementSpaceProfile.h"
+#include "Types/PLSplineLookupTable.h"
 #include "PLPlayerStart.generated.h"
 
 /**
@@ -39,7 +40,25 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Movement Space")
 	const ACameraActor *GetSpawnCamera();
 
+	/**
+	 * Returns the movement space transition for the spawning player, which combines the movement space state, the spline and the camera.
+	 * @return The transition to apply to the spawned player.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Movement Space")
+	FPLMovementSpaceTransition GetSpawnMovementSpaceTransition();
+
 protected:
+	/** Resolves the spline of the spawn, so that no spawn or respawn has to search for it, and registers the PlayerStart at the UPLPlayerStartSubsystem. */
+	virtual void BeginPlay() override;
+
+	/** Unregisters the PlayerStart from the UPLPlayerStartSubsystem. */
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+#if WITH_EDITOR
+	/** Bakes the lookup table of the spawn spline, so that it is serialized with the level. */
+	virtual void PreSave(FObjectPreSaveContext ObjectSaveContext) override;
+#endif
+
 	/** Member indicating the space the spawned player is able to move in.*/
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Config")
 	EPLMovementSpaceState MovementSpaceSpawn{EPLMovementSpaceState::MovementIn2D};
@@ -55,4 +74,8 @@ protected:
 	/** Reference to an ACameraActor in the world to use on spawn. If not set, we use the default camera of the player.*/
 	UPROPERTY(EditAnywhere, Category = "Config")
 	TWeakObjectPtr<ACameraActor> SpawnCamera{nullptr};
+
+	/** Lookup table of the spawn spline baked on save and registered at the UPLSplineLookupSubsystem on the begin of play. */
+	UPROPERTY()
+	FPLSplineLookupTable MovementSplineLookupTable{};
 };
@@ -0,0 +1,73 @@
+// Copyright TinyAlmonds (Alex Noerdemann)
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/SoftObjectPath.h"
+
+#include "Core/Types/PLMovementSpaceState.h"
+
+// Forward declarations
+class APLCharacter;
+class FArchive;
+
+/**
+ * Compact snapshot of the save-relevant state of an APLCharacter: The base values of the attributes of the UPLCharacterAttributeSet
+ * and UPLMovementAttributeSet, the granted ability classes, the movement space state and the movement spline.
+ * The snapshot is serialized with a versioned, fixed layout (i.e. the attribute order is defined by the code, not by reflection)
+ * and restored by setting the attribute base values directly instead of applying GameplayEffects.
+ */
+struct PROJECTLUX_API FPLCharacterSnapshot
+{
+	/** Identifier at the start of every serialized snapshot. */
+	static constexpr uint32 Magic{0x53434C50}; // "PLCS"
+
+	/** Version of the layout. Has to be increased, whenever the serialized layout (e.g. the attribute layout) changes. */
+	static constexpr uint16 LayoutVersion{1};
+
+	/** Base values of the attributes in the order of the attribute layout. */
+	TArray<float> AttributeBaseValues;
+
+	/** Classes of the granted abilities. */
+	TArray<FSoftClassPath> AbilityClasses;
+
+	/** The movement space state of the character. */
+	EPLMovementSpaceState MovementSpace{EPLMovementSpaceState::MovementIn3D};
+
+	/** Path of the spline component the character moves on. Empty, if the character has no spline. */
+	FSoftObjectPath MovementSplinePath;
+
+	/**
+	 * Captures the snapshot of the given character.
+	 * @param Character - The character to capture.
+	 * @return The snapshot of the character.
+	 */
+	static FPLCharacterSnapshot Capture(APLCharacter &Character);
+
+	/**
+	 * Restores the snapshot on the given character: Sets the attribute base values, grants/removes abilities so that the granted classes match and applies the movement space.
+	 * The movement in 3D is restored instead, if the movement spline of the snapshot is not found.
+	 * @param Character - The character to restore.
+	 */
+	void Restore(APLCharacter &Character) const;
+
+	/**
+	 * Serializes the snapshot to or from the given archive.
+	 * @param Ar - The archive to serialize with.
+	 * @return True on success; False if a loaded snapshot has an unknown identifier, version or layout (the archive is set to an error state).
+	 */
+	bool Serialize(FArchive &Ar);
+
+	/**
+	 * Serializes the snapshot into the given buffer.
+	 * @param OutBuffer - The buffer to write to. Existing content is replaced, but its allocation is reused.
+	 */
+	void SaveToBuffer(TArray<uint8> &OutBuffer) const;
+
+	/**
+	 * Deserializes a snapshot from the given buffer.
+	 * @param Buffer - The buffer holding a serialized snapshot.
+	 * @param OutSnapshot - The loaded snapshot. Only valid, if True is returned.
+	 * @return True if the snapshot was loaded; False otherwise.
+	 */
+	static bool LoadFromBuffer(const TArray<uint8> &Buffer, FPLCharacterSnapshot &OutSnapshot);
+};
@@ -0,0 +1,154 @@
+// Copyright TinyAlmonds (Alex Noerdemann)
+#pragma once
+
+#include "Async/Future.h"
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+
+#include "PLSaveGameSubsystem.generated.h"
+
+// Forward declarations
+class APLCharacter;
+struct FPLCharacterSnapshot;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FPLOnSaveGameWritten, bool, bSuccess, int64, SequenceNumber);
+
+/**
+ * Native save service for checkpoint saves of the APLCharacter.
+ * The character state is captured on the game thread into a preallocated buffer (see FPLCharacterSnapshot). Compression and the file write run on a background task.
+ * Saves alternate between two slot files, whose header holds a sequence number and a checksum of the payload, so that an interrupted write never corrupts the previous save.
+ */
+UCLASS()
+class PROJECTLUX_API UPLSaveGameSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Called when a save was written (or failed to be written). Broadcasted on the game thread. */
+	UPROPERTY(BlueprintAssignable, Category = "SaveGame")
+	FPLOnSaveGameWritten OnSaveGameWritten;
+
+	/** Reads the headers of both slots to continue the sequence of the latest valid save. */
+	virtual void Initialize(FSubsystemCollectionBase &Collection) override;
+
+	/** Drains a running write and writes a queued save after it, so that no save gets lost on shutdown. */
+	virtual void Deinitialize() override;
+
+	/**
+	 * Captures the state of the given character and writes it asynchronously. If a write is running, the save is queued.
+	 * Queued saves are coalesced, i.e. only the most recent one is written.
+	 * @param Character - The character to save.
+	 * @return True if the save was started or queued; False otherwise.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "SaveGame")
+	bool SaveCharacterAsync(APLCharacter *Character);
+
+	/**
+	 * Restores the given character from the latest valid save.
+	 * @param Character - The character to restore.
+	 * @return True if a valid save was found and restored; False otherwise.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "SaveGame")
+	bool RestoreCharacter(APLCharacter *Character) const;
+
+	/**
+	 * Loads the character snapshot of the latest valid save.
+	 * @param OutSnapshot - The loaded snapshot. Only valid, if True is returned.
+	 * @return True if a valid save was found; False otherwise.
+	 */
+	bool LoadLatestCharacterSnapshot(FPLCharacterSnapshot &OutSnapshot) const;
+
+	/**
+	 * Checks, whether a save is currently written.
+	 * @return True if a write is running; False otherwise.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "SaveGame")
+	bool IsWriteInProgress() const;
+
+private:
+	/** Header at the start of every slot file. */
+	struct FPLSaveSlotHeader
+	{
+		static constexpr uint32 Magic{0x56534C50}; // "PLSV"
+		static constexpr uint16 FormatVersion{1};
+
+		uint64 SequenceNumber{0};
+		uint32 UncompressedSize{0};
+		uint32 CompressedSize{0};
+		uint32 PayloadCrc{0};
+
+		/**
+		 * Serializes the header to or from the given archive.
+		 * @param Ar - The archive to serialize with.
+		 * @return True on success; False if a loaded header has an unknown identifier or version.
+		 */
+		bool Serialize(FArchive &Ar);
+	};
+
+	/** Number of slot files, which are written alternately. */
+	static constexpr int32 NumSlots{2};
+
+	/** Initial size of the preallocated buffers [bytes]. */
+	static constexpr int32 InitialBufferSize{4 * 1024};
+
+	/**
+	 * Starts the background task writing the snapshot buffer with the given index.
+	 * @param SnapshotBufferIndex - Index of the snapshot buffer to write.
+	 */
+	void StartWrite(int32 SnapshotBufferIndex);
+
+	/**
+	 * Called on the game thread, when the background write finished.
+	 * @param bSuccess - Whether the write succeeded.
+	 * @param Slot - The slot, which was written.
+	 * @param WriteSequenceNumber - The sequence number of the written save.
+	 */
+	void OnWriteFinished(bool bSuccess, int32 Slot, uint64 WriteSequenceNumber);
+
+	/**
+	 * Compresses the given snapshot and writes it with header into the given slot file. Runs on a background thread.
+	 * @param SnapshotBuffer - The serialized snapshot.
+	 * @param OutFileBuffer - Preallocated buffer for the file content.
+	 * @param SlotFilePath - Path of the slot file to write.
+	 * @param SaveSequenceNumber - The sequence number of the save.
+	 * @return True if the file was written; False otherwise.
+	 */
+	static bool WriteSlotFile(const TArray<uint8> &SnapshotBuffer, TArray<uint8> &OutFileBuffer, const FString &SlotFilePath, uint64 SaveSequenceNumber);
+
+	/**
+	 * Reads and validates the given slot file.
+	 * @param SlotFilePath - Path of the slot file to read.
+	 * @param OutHeader - The header of the slot.
+	 * @param OutSnapshotBuffer - If not nullptr, the decompressed snapshot is written into it.
+	 * @return True if the slot holds a valid save; False otherwise.
+	 */
+	static bool ReadSlotFile(const FString &SlotFilePath, FPLSaveSlotHeader &OutHeader, TArray<uint8> *OutSnapshotBuffer);
+
+	/**
+	 * Returns the path of the given slot file.
+	 * @param Slot - The slot index.
+	 * @return The path of the slot file.
+	 */
+	static FString GetSlotFilePath(int32 Slot);
+
+	/** Buffers the snapshots are serialized into. One is written by the background task, while the other one receives the next save. */
+	TArray<uint8> SnapshotBuffers[NumSlots];
+
+	/** Buffer for the compressed file content. Only used by the background task. */
+	TArray<uint8> FileBuffer;
+
+	/** Index of the snapshot buffer, which is written by the background task. INDEX_NONE, if no write is running. */
+	int32 InFlightSnapshotBufferIndex{INDEX_NONE};
+
+	/** Index of the snapshot buffer holding a queued save. INDEX_NONE, if no save is queued. */
+	int32 QueuedSnapshotBufferIndex{INDEX_NONE};
+
+	/** The slot holding the latest valid save. The next save is written into the other slot. */
+	int32 LatestValidSlot{NumSlots - 1};
+
+	/** The sequence number of the latest started save. */
+	uint64 SequenceNumber{0};
+
+	/** Future of the running background write. Holds whether the write succeeded. */
+	TFuture<bool> WriteFuture;
+};
@@ -0,0 +1,109 @@
+// Copyright TinyAlmonds (Alex Noerdemann)
+#pragma once
+
+#include "BehaviorTree/BlackboardComponent.h"
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+
+#include "PLEnemyDirectorSubsystem.generated.h"
+
+// Forward declarations
+class APawn;
+class APLEnemyCharacterBase;
+
+/**
+ * WorldSubsystem computing the perception of the player for all registered enemies once per frame: The location and velocity of the player as well as the distance and line of sight of every enemy.
+ * The results are published to the blackboards of the enemies' AIControllers, so that the behavior trees do not query the player independently.
+ * Blackboard keys, which are missing in the blackboard asset of an enemy, are skipped.
+ */
+UCLASS()
+class PROJECTLUX_API UPLEnemyDirectorSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Name of the blackboard key (Object) receiving the player pawn. */
+	static const FName PlayerKeyName;
+
+	/** Name of the blackboard key (Vector) receiving the location of the player. */
+	static const FName PlayerLocationKeyName;
+
+	/** Name of the blackboard key (Vector) receiving the velocity of the player. */
+	static const FName PlayerVelocityKeyName;
+
+	/** Name of the blackboard key (Float) receiving the distance between the enemy and the player. */
+	static const FName DistanceToPlayerKeyName;
+
+	/** Name of the blackboard key (Bool) receiving, whether the enemy has a line of sight to the player. */
+	static const FName HasLineOfSightToPlayerKeyName;
+
+	/**
+	 * Registers the given enemy, so that its blackboard receives the perception of the player.
+	 * @param Enemy - The enemy to register.
+	 */
+	void RegisterEnemy(APLEnemyCharacterBase *Enemy);
+
+	/**
+	 * Unregisters the given enemy.
+	 * @param Enemy - The enemy to unregister.
+	 */
+	void UnregisterEnemy(APLEnemyCharacterBase *Enemy);
+
+	/**
+	 * Returns the number of registered enemies.
+	 * @return The number of registered enemies.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "EnemyDirector")
+	int32 GetNumEnemies() const;
+
+	/**
+	 * Returns the memory allocated by the registered enemies (e.g. for the memory report).
+	 * @return The allocated size [bytes].
+	 */
+	SIZE_T GetAllocatedSize() const;
+
+	/** Computes the perception of the player and publishes it to the blackboards of all registered enemies. */
+	virtual void Tick(float DeltaTime) override;
+
+	/** Returns the stat id of the tick. */
+	virtual TStatId GetStatId() const override;
+
+protected:
+	/** Only game worlds have enemies to direct. */
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	/** A registered enemy with the resolved blackboard keys of its blackboard asset. */
+	struct FPLDirectedEnemy
+	{
+		/** The registered enemy. */
+		TWeakObjectPtr<APLEnemyCharacterBase> Enemy;
+
+		/** The blackboard asset the keys were resolved for. Resolved again, if the blackboard asset changes (e.g. on a new behavior tree). */
+		TWeakObjectPtr<const UBlackboardData> BlackboardAsset;
+
+		FBlackboard::FKey PlayerKey{FBlackboard::InvalidKey};
+		FBlackboard::FKey PlayerLocationKey{FBlackboard::InvalidKey};
+		FBlackboard::FKey PlayerVelocityKey{FBlackboard::InvalidKey};
+		FBlackboard::FKey DistanceToPlayerKey{FBlackboard::InvalidKey};
+		FBlackboard::FKey HasLineOfSightToPlayerKey{FBlackboard::InvalidKey};
+	};
+
+	/**
+	 * Resolves the blackboard keys of the given enemy, if the blackboard asset changed.
+	 * @param DirectedEnemy - The enemy to update.
+	 * @param BlackboardComponent - The current blackboard of the enemy.
+	 */
+	static void ResolveBlackboardKeys(FPLDirectedEnemy &DirectedEnemy, const UBlackboardComponent &BlackboardComponent);
+
+	/**
+	 * Checks, whether the given enemy sees the player.
+	 * @param Enemy - The enemy.
+	 * @param Player - The player pawn.
+	 * @return True if no visibility blocking geometry is in between; False otherwise.
+	 */
+	bool HasLineOfSight(const APLEnemyCharacterBase &Enemy, const APawn &Player) const;
+
+	/** The registered enemies. */
+	TArray<FPLDirectedEnemy> DirectedEnemies;
+};
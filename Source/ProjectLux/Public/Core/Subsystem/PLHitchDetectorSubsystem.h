@@ -0,0 +1,219 @@
+// Copyright TinyAlmonds (Alex Noerdemann)
+#pragma once
+
+#include "Async/Future.h"
+#include "CoreMinimal.h"
+#include "Subsystems/EngineSubsystem.h"
+
+#include <atomic>
+
+#include "PLHitchDetectorSubsystem.generated.h"
+
+/** Whether the stage timers of the hitch detector are compiled in. Shipping builds compile them out, test builds keep them. */
+#define PL_WITH_HITCH_DETECTOR (!UE_BUILD_SHIPPING)
+
+/**
+ * Enumeration for the stages of the project timed by the UPLHitchDetectorSubsystem.
+ * @note Adding, removing or reordering stages changes the dump layout and requires a new FPLHitchDump::FormatVersion.
+ */
+UENUM(BlueprintType)
+enum class EPLHitchStage : uint8
+{
+	/** APLCharacter::Tick() (including the wall slide check). */
+	CharacterTick,
+	/** The wall slide check of the APLCharacter. */
+	CharacterWallSlide,
+	/** The tick of the UPLCharacterMovementComponent. */
+	CharacterMovement,
+	/** Ability activations of the UPLAbilitySystemComponent. */
+	AbilityActivation,
+	/** Executions of the UPLAttackDamageExecution. */
+	DamageExecution,
+	/** The tick of the UPLMeleeHitComponent. */
+	MeleeHit,
+	/** The tick of the UPLChaseActorAlongSplineComponent. */
+	ChaseUpdate,
+	/** The tick of the UPLTrackActorComponent. */
+	TrackUpdate,
+	/** The tick of the UPLEnemyDirectorSubsystem. */
+	EnemyDirector,
+	/** Respawns of the player and spawns of the stress test cheats. */
+	Spawn,
+	/** Captures and restores of the UPLSaveGameSubsystem. */
+	Save,
+	Num UMETA(Hidden)
+};
+
+/** A frame recorded by the UPLHitchDetectorSubsystem. */
+struct PROJECTLUX_API FPLHitchFrame
+{
+	/** Number of the frame (GFrameCounter). */
+	uint64 FrameNumber{0};
+
+	/** Time of the whole frame [ms]. */
+	float FrameTime{0.0f};
+
+	/** Time spent in every stage [ms]. Nested stages are included in the time of the outer stage. */
+	float StageTimes[static_cast<int32>(EPLHitchStage::Num)]{};
+
+	/** Number of times every stage ran. */
+	uint16 StageCounts[static_cast<int32>(EPLHitchStage::Num)]{};
+};
+
+/** The recorded frames written when a frame exceeded the budget. The last frame is the hitch. */
+struct PROJECTLUX_API FPLHitchDump
+{
+	static constexpr uint32 Magic{0x44484C50}; // "PLHD"
+	static constexpr uint16 FormatVersion{1};
+
+	/** The frame budget, which was exceeded [ms]. */
+	float FrameBudget{0.0f};
+
+	/** The recorded frames in chronological order. */
+	TArray<FPLHitchFrame> Frames;
+
+	/**
+	 * Serializes the dump to or from the given archive.
+	 * @param Ar - The archive to serialize with.
+	 * @return True on success; False if a loaded dump has an unknown identifier, version or number of stages.
+	 */
+	bool Serialize(FArchive &Ar);
+};
+
+/**
+ * EngineSubsystem recording the time per stage of the project (see EPLHitchStage) for the last frames in a ring buffer.
+ * The stages are timed by PL_SCOPE_HITCH_STAGE(), which only adds to lock-free counters, so that the recording stays enabled in test builds (projectlux.Hitch.Enabled).
+ * When a frame exceeds the budget (projectlux.Hitch.Budget), the buffer is compressed into a dump file in the profiling directory on a background task.
+ */
+UCLASS()
+class PROJECTLUX_API UPLHitchDetectorSubsystem : public UEngineSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Number of frames in the ring buffer. */
+	static constexpr int32 NumRecordedFrames{300};
+
+	/** Hooks the recording into the end of every frame. */
+	virtual void Initialize(FSubsystemCollectionBase &Collection) override;
+
+	/** Waits for a running dump write and unhooks the recording. */
+	virtual void Deinitialize() override;
+
+	/**
+	 * Adds the given time to the given stage of the current frame. Thread-safe and lock-free.
+	 * @param Stage - The timed stage.
+	 * @param Cycles - The time spent in the stage [cycles].
+	 */
+	static void AddStageTime(EPLHitchStage Stage, uint64 Cycles);
+
+	/**
+	 * Checks, whether the stages are recorded.
+	 * @return True if the stage timers should measure; False otherwise.
+	 */
+	static bool IsRecording();
+
+	/**
+	 * Returns the directory of the dump files.
+	 * @return The directory path.
+	 */
+	static FString GetDumpDirectory();
+
+	/**
+	 * Returns the path of the most recent dump file.
+	 * @return The file path; empty if no dump exists.
+	 */
+	static FString FindLatestDumpFile();
+
+	/**
+	 * Reads the given dump file.
+	 * @param DumpFilePath - The path of the dump file.
+	 * @param OutDump - The read dump. Only valid, if True is returned.
+	 * @return True if the file holds a valid dump; False otherwise.
+	 */
+	static bool ReadDumpFile(const FString &DumpFilePath, FPLHitchDump &OutDump);
+
+	/**
+	 * Returns the memory allocated by the ring buffer of the recorded frames (e.g. for the memory report).
+	 * @return The allocated size [bytes].
+	 */
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	/**
+	 * Records the stage times of the ended frame and dumps the buffer, if the frame exceeded the budget. Called on the game thread.
+	 */
+	void OnEndFrame();
+
+	/**
+	 * Compresses the recorded frames and writes them into a new dump file on a background task.
+	 * @param FrameBudget - The exceeded frame budget [ms].
+	 */
+	void WriteDump(float FrameBudget);
+
+	/** Stage times of the current frame [cycles]. Written by the stage timers of all threads. */
+	static std::atomic<uint64> StageCycles[static_cast<int32>(EPLHitchStage::Num)];
+
+	/** Stage counts of the current frame. Written by the stage timers of all threads. */
+	static std::atomic<uint32> StageCounts[static_cast<int32>(EPLHitchStage::Num)];
+
+	/** Whether the stages are recorded. Mirrors projectlux.Hitch.Enabled, so that the stage timers do not read the console variable. */
+	static std::atomic<bool> bRecording;
+
+	/** The ring buffer of the recorded frames. Only touched by the game thread. */
+	TArray<FPLHitchFrame> RecordedFrames;
+
+	/** Index of the slot in RecordedFrames receiving the next frame. */
+	int32 NextFrameSlot{0};
+
+	/** Number of frames recorded since the recording started (or the last dump). */
+	int32 NumFramesSinceDump{0};
+
+	/** Time of the end of the previous frame [cycles]. */
+	uint64 PreviousEndFrameCycles{0};
+
+	/** Handle of the end frame hook. */
+	FDelegateHandle EndFrameHandle;
+
+	/** Future of the running dump write. */
+	TFuture<void> WriteFuture;
+};
+
+/** Scope adding its lifetime to a stage of the UPLHitchDetectorSubsystem. Use PL_SCOPE_HITCH_STAGE(). */
+struct PROJECTLUX_API FPLScopedHitchStage
+{
+	/**
+	 * Starts timing the given stage, if the hitch detector is recording.
+	 * @param InStage - The timed stage.
+	 */
+	explicit FPLScopedHitchStage(EPLHitchStage InStage)
+		: Stage{InStage}, StartCycles{UPLHitchDetectorSubsystem::IsRecording() ? FPlatformTime::Cycles64() : 0}
+	{
+	}
+
+	/** Adds the time since the construction to the stage. */
+	~FPLScopedHitchStage()
+	{
+		if (StartCycles != 0)
+		{
+			UPLHitchDetectorSubsystem::AddStageTime(Stage, FPlatformTime::Cycles64() - StartCycles);
+		}
+	}
+
+	FPLScopedHitchStage(const FPLScopedHitchStage &) = delete;
+	FPLScopedHitchStage &operator=(const FPLScopedHitchStage &) = delete;
+
+private:
+	/** The timed stage. */
+	EPLHitchStage Stage;
+
+	/** The time of the construction [cycles]. 0, if not recording. */
+	uint64 StartCycles;
+};
+
+#if PL_WITH_HITCH_DETECTOR
+/** Times the rest of the enclosing scope as the given EPLHitchStage (e.g. PL_SCOPE_HITCH_STAGE(TrackUpdate)). */
+#define PL_SCOPE_HITCH_STAGE(StageName) const FPLScopedHitchStage PREPROCESSOR_JOIN(PLScopedHitchStage, __LINE__){EPLHitchStage::StageName}
+#else
+#define PL_SCOPE_HITCH_STAGE(StageName)
+#endif
@@ -0,0 +1,102 @@
+// Copyright TinyAlmonds (Alex Noerdemann)
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+
+#include "PLLocalPlayersSubsystem.generated.h"
+
+// Forward declarations
+class AActor;
+class APawn;
+
+/**
+ * WorldSubsystem caching the pawns and locations of all local players (e.g. of a splitscreen co-op) once per frame.
+ * Actors asking for their nearest player are remembered and answered in one batch per frame, so that components targeting the nearest player do not scan the players themselves.
+ */
+UCLASS()
+class PROJECTLUX_API UPLLocalPlayersSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Distance another player has to be closer than the current nearest player, before the nearest player changes [uu]. Avoids flickering between equally distant players. */
+	static constexpr float NearestPlayerSwitchDistance{100.0f};
+
+	/**
+	 * Returns the number of local players with a pawn in the previous frame.
+	 * @return The number of local player pawns.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "LocalPlayers")
+	int32 GetNumLocalPlayerPawns() const;
+
+	/**
+	 * Returns the local player pawn closest to the given location, using the cached locations of the previous frame.
+	 * @param Location - The world location.
+	 * @return The closest local player pawn; nullptr if no local player has a pawn.
+	 */
+	APawn *FindNearestPlayerPawn(const FVector &Location) const;
+
+	/**
+	 * Returns the local player pawn nearest to the given actor. The actor is added to the batch computed once per frame on its first call
+	 * and removed again, if it does not ask for a whole frame.
+	 * @param Querier - The actor asking for its nearest player.
+	 * @return The nearest local player pawn; nullptr if no local player has a pawn.
+	 */
+	APawn *GetNearestPlayerPawn(const AActor *Querier);
+
+	/**
+	 * Returns the memory allocated by the cached player pawns and the batch of the nearest player queries (e.g. for the memory report).
+	 * @return The allocated size [bytes].
+	 */
+	SIZE_T GetAllocatedSize() const;
+
+	/** Caches the local player pawns and computes the nearest player of all queriers. */
+	virtual void Tick(float DeltaTime) override;
+
+	/** Returns the stat id of the tick. */
+	virtual TStatId GetStatId() const override;
+
+protected:
+	/** Only game worlds have local players. */
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	/** A cached local player pawn. */
+	struct FPLLocalPlayerPawn
+	{
+		/** The pawn of the local player. */
+		TWeakObjectPtr<APawn> Pawn;
+
+		/** The location of the pawn, when it was cached. */
+		FVector Location{FVector::ZeroVector};
+	};
+
+	/** The nearest player of an actor. */
+	struct FPLNearestPlayerQuery
+	{
+		/** The nearest local player pawn. */
+		TWeakObjectPtr<APawn> NearestPlayer;
+
+		/** Flag indicating whether the querier asked since the last batch. */
+		bool bQueried{true};
+	};
+
+	/** Caches the pawns and locations of the local players. */
+	void CacheLocalPlayerPawns();
+
+	/**
+	 * Returns the index of the cached player pawn closest to the given location.
+	 * @param Location - The world location.
+	 * @param CurrentNearestPlayer - The current nearest player, which is kept unless another player is NearestPlayerSwitchDistance closer.
+	 * @return The index in LocalPlayerPawns; INDEX_NONE if no local player has a pawn.
+	 */
+	int32 FindNearestPlayerIndex(const FVector &Location, const APawn *CurrentNearestPlayer) const;
+
+	/** The cached local player pawns (usually up to four in a splitscreen). */
+	TArray<FPLLocalPlayerPawn, TInlineAllocator<4>> LocalPlayerPawns;
+
+	/** The nearest players of the actors asking for them. */
+	TMap<TObjectKey<AActor>, FPLNearestPlayerQuery> NearestPlayerQueries;
+};
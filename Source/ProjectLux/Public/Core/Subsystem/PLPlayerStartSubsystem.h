@@ -0,0 +1,78 @@
+// Copyright TinyAlmonds (Alex Noerdemann)
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+
+#include "Core/Types/PLMovementSpaceProfile.h"
+#include "PLPlayerStartSubsystem.generated.h"
+
+// Forward declarations
+class AController;
+class APLPlayerStart;
+
+/** Registered APLPlayerStart together with its resolved spawn settings. */
+USTRUCT()
+struct PROJECTLUX_API FPLPlayerStartEntry
+{
+	GENERATED_BODY()
+
+	/** The registered PlayerStart. */
+	UPROPERTY()
+	APLPlayerStart *PlayerStart{nullptr};
+
+	/** The movement space transition (state, spline and camera) of the PlayerStart. */
+	UPROPERTY()
+	FPLMovementSpaceTransition SpawnTransition{};
+};
+
+/**
+ * WorldSubsystem indexing all APLPlayerStart actors of the world by their PlayerStartTag, so that teleports and checkpoint lookups do not have to iterate the actors of the world.
+ */
+UCLASS()
+class PROJECTLUX_API UPLPlayerStartSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Registers the given PlayerStart by its PlayerStartTag. PlayerStarts without a tag are not registered.
+	 * @param PlayerStart - The PlayerStart to register.
+	 */
+	void RegisterPlayerStart(APLPlayerStart *PlayerStart);
+
+	/**
+	 * Unregisters the given PlayerStart.
+	 * @param PlayerStart - The PlayerStart to unregister.
+	 */
+	void UnregisterPlayerStart(APLPlayerStart *PlayerStart);
+
+	/**
+	 * Returns the PlayerStart with the given tag.
+	 * @param PlayerStartTag - The tag of the PlayerStart.
+	 * @return The PlayerStart if registered; nullptr otherwise.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "PlayerStart")
+	APLPlayerStart *FindPlayerStart(FName PlayerStartTag) const;
+
+	/**
+	 * Returns the registered entry of the PlayerStart with the given tag.
+	 * @param PlayerStartTag - The tag of the PlayerStart.
+	 * @return A pointer to the entry if registered; nullptr otherwise.
+	 */
+	const FPLPlayerStartEntry *FindPlayerStartEntry(FName PlayerStartTag) const;
+
+	/**
+	 * Teleports the pawn of the given player to the PlayerStart with the given tag and applies the movement space transition of the PlayerStart.
+	 * @param Player - The controller of the player to teleport.
+	 * @param PlayerStartTag - The tag of the PlayerStart.
+	 * @return True if the player was teleported; False otherwise.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "PlayerStart")
+	bool TeleportToPlayerStart(AController *Player, FName PlayerStartTag) const;
+
+private:
+	/** The registered PlayerStarts by their PlayerStartTag. */
+	UPROPERTY()
+	TMap<FName, FPLPlayerStartEntry> PlayerStarts;
+};
@@ -0,0 +1,68 @@
+// Copyright TinyAlmonds (Alex Noerdemann)
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+
+#include "PLSplineLookupSubsystem.generated.h"
+
+// Forward declarations
+class USplineComponent;
+struct FPLSplineLookupTable;
+
+/**
+ * WorldSubsystem indexing the baked FPLSplineLookupTables of the world by their spline. The tables are owned and serialized by the actors and components referencing the
+ * splines (e.g. APLPlayerStart) and registered on the begin of play, so that every user of a spline (e.g. the UPLCharacterMovementComponent) finds its baked table.
+ * The tables are never built at runtime: Splines without a valid baked table are queried directly.
+ */
+UCLASS()
+class PROJECTLUX_API UPLSplineLookupSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Registers the given table for the given spline, if it is valid for the spline and no table is registered for the spline yet.
+	 * @param Spline - The spline of the table.
+	 * @param LookupTable - The baked table. Has to outlive the registration.
+	 */
+	void RegisterLookupTable(const USplineComponent *Spline, const FPLSplineLookupTable &LookupTable);
+
+	/**
+	 * Unregisters the given table of the given spline.
+	 * @param Spline - The spline of the table.
+	 * @param LookupTable - The registered table.
+	 */
+	void UnregisterLookupTable(const USplineComponent *Spline, const FPLSplineLookupTable &LookupTable);
+
+	/**
+	 * Returns the baked table of the given spline.
+	 * @param Spline - The spline.
+	 * @return The table if registered; nullptr otherwise.
+	 */
+	const FPLSplineLookupTable *FindLookupTable(const USplineComponent *Spline) const;
+
+	/**
+	 * Returns the baked table of the given spline from the subsystem of the spline's world.
+	 * @param Spline - The spline.
+	 * @return The table if registered; nullptr otherwise.
+	 */
+	static const FPLSplineLookupTable *FindLookupTableOfSpline(const USplineComponent *Spline);
+
+	/**
+	 * Returns whether the baked tables are used (projectlux.FastPath.SplineLookupTables), so that they can be compared with the direct spline queries at runtime.
+	 * @return True if the users of the splines should use the baked tables; False if they should query the splines directly.
+	 */
+	static bool AreLookupTablesEnabled();
+
+	/**
+	 * Returns the memory allocated by the index and the samples of the registered tables (e.g. for the memory report).
+	 * @return The allocated size [bytes].
+	 */
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	/** The registered tables per spline. */
+	TMap<TObjectKey<USplineComponent>, const FPLSplineLookupTable *> LookupTables;
+};
@@ -0,0 +1,135 @@
+// Copyright TinyAlmonds (Alex Noerdemann)
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+
+#include "PLWallProximitySubsystem.generated.h"
+
+// Forward declarations
+class AActor;
+class ULevel;
+class UPrimitiveComponent;
+
+/**
+ * WorldSubsystem holding a sparse grid of the components, which block the Wallslide trace channel. The grid is baked on the begin of play and answers, whether a trace segment
+ * can hit a wall at all, so that characters only issue the wall slide trace when a wall is near.
+ * The cells store the bounds of the static walls; movable and very large walls are checked by their current bounds on every query. The answers are conservative: A wall is never
+ * missed, but a positive answer still has to be confirmed by a trace (which also delivers the exact normal of the wall).
+ * Actors spawned after the bake are added on the next query, so that their collision responses can be set up after the spawn. The walls of streamed levels are added, when the
+ * level becomes visible, and removed, when it is removed from the world.
+ */
+UCLASS()
+class PROJECTLUX_API UPLWallProximitySubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Trace channel of the wall slide (named "Wallslide" in the collision settings). */
+	static constexpr ECollisionChannel WallSlideTraceChannel{ECC_GameTraceChannel1};
+
+	/**
+	 * Checks, whether the given segment can hit a component blocking the Wallslide trace channel.
+	 * @param Start - The start of the segment.
+	 * @param End - The end of the segment.
+	 * @return True if a wall is in the cells of the segment or the grid is not baked yet; False if the segment cannot hit a wall.
+	 */
+	bool MayHitWall(const FVector &Start, const FVector &End);
+
+	/**
+	 * Returns the number of baked cells containing walls.
+	 * @return The number of cells.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "WallSlide")
+	int32 GetNumCells() const;
+
+	/**
+	 * Returns the memory allocated by the walls and the cells of the grid (e.g. for the memory report).
+	 * @return The allocated size [bytes].
+	 */
+	SIZE_T GetAllocatedSize() const;
+
+	/** Bakes the grid from the components of the world. */
+	virtual void OnWorldBeginPlay(UWorld &InWorld) override;
+
+	/** Removes the spawn and level streaming handlers. */
+	virtual void Deinitialize() override;
+
+protected:
+	/** Only game worlds have characters sliding on walls. */
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	/** Edge length of the cells [uu]. */
+	static constexpr double CellSize{256.0};
+
+	/** Maximum number of cells a static wall is added to. Walls with larger bounds (e.g. a landscape) are checked on every query. */
+	static constexpr int32 MaxCellsPerWall{512};
+
+	/** A component blocking the Wallslide trace channel. */
+	struct FPLWallEntry
+	{
+		/** The bounds of the component on the bake. */
+		FBox Bounds;
+
+		/** The component. */
+		TWeakObjectPtr<UPrimitiveComponent> Component;
+	};
+
+	/**
+	 * Adds all components of the given actor, which block the Wallslide trace channel.
+	 * @param Actor - The actor to add.
+	 */
+	void AddWallsOfActor(const AActor &Actor);
+
+	/**
+	 * Clears the grid and adds the walls of all actors of the given world.
+	 * @param World - The world.
+	 * @param ExcludedLevel - Level whose actors are not added (e.g. a level, which is being removed).
+	 */
+	void Bake(UWorld &World, const ULevel *ExcludedLevel = nullptr);
+
+	/**
+	 * Returns the cell coordinates of the given location.
+	 * @param Location - The location.
+	 * @return The cell coordinates.
+	 */
+	static FIntVector GetCell(const FVector &Location);
+
+	/** Queues an actor spawned after the bake. */
+	void OnActorSpawned(AActor *Actor);
+
+	/** Adds the queued actors to the grid. */
+	void AddPendingActors();
+
+	/** Queues the actors of a level streamed into the world. */
+	void OnLevelAddedToWorld(ULevel *Level, UWorld *World);
+
+	/** Rebakes the grid without the actors of a level streamed out of the world. */
+	void OnLevelRemovedFromWorld(ULevel *Level, UWorld *World);
+
+	/** The static walls referenced by the cells. */
+	TArray<FPLWallEntry> StaticWalls;
+
+	/** Indices into StaticWalls per cell. */
+	TMap<FIntVector, TArray<int32, TInlineAllocator<4>>> Cells;
+
+	/** Movable and very large walls, which are checked on every query. */
+	TArray<TWeakObjectPtr<UPrimitiveComponent>> UnbakedWalls;
+
+	/** Actors spawned after the bake, which were not added yet. */
+	TArray<TWeakObjectPtr<AActor>> PendingActors;
+
+	/** Handle of the actor spawn handler of the world. */
+	FDelegateHandle ActorSpawnedHandle;
+
+	/** Handle of the level added handler. */
+	FDelegateHandle LevelAddedHandle;
+
+	/** Handle of the level removed handler. */
+	FDelegateHandle LevelRemovedHandle;
+
+	/** Flag indicating whether the grid was baked. */
+	bool bBaked{false};
+};
@@ -0,0 +1,16 @@
+// Copyright TinyAlmonds (Alex Noerdemann)
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "PLGravityScaleOverrideSource.generated.h"
+
+/**
+ * Enum indicating the source (e.g. an ability), which overrides the GravityScale of the UPLCharacterMovementComponent.
+ * @note Only the WallSlide is stacked for now. The Dash and Glide abilities still write the GravityScale directly in Blueprint and get their sources, when they are migrated.
+ */
+UENUM(BlueprintType)
+enum class EPLGravityScaleOverrideSource : uint8
+{
+	WallSlide
+};
@@ -0,0 +1,88 @@
+// Copyright TinyAlmonds (Alex Noerdemann)
+#pragma once
+
+#include "Camera/PlayerCameraManager.h"
+#include "CoreMinimal.h"
+#include "Engine/EngineTypes.h"
+
+#include "Core/Types/PLMovementSpaceState.h"
+#include "PLMovementSpaceProfile.generated.h"
+
+// Forward declarations
+class ACameraActor;
+class USplineComponent;
+
+/** Settings of the movement of the APLCharacter in an EPLMovementSpaceState. */
+USTRUCT(BlueprintType)
+struct PROJECTLUX_API FPLMovementSpaceProfile
+{
+	GENERATED_BODY()
+
+	/** Whether the movement is constrained to a plane. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Movement Space")
+	bool bPlaneConstraintEnabled{false};
+
+	/** The plane the movement is constrained to, if the plane constraint is enabled. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Movement Space")
+	EPlaneConstraintAxisSetting PlaneConstraintAxisSetting{EPlaneConstraintAxisSetting::Custom};
+
+	/** Whether the movement is constrained to the movement spline. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Movement Space")
+	bool bConstrainToSpline{false};
+
+	/** The time of the blend to the camera of a transition into the state [s]. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Movement Space|Camera")
+	float CameraBlendTime{0.0f};
+
+	/** The function of the blend to the camera of a transition into the state. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Movement Space|Camera")
+	TEnumAsByte<EViewTargetBlendFunction> CameraBlendFunction{VTBlend_Linear};
+
+	/** The exponent of the blend function, if it eases in or out. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Movement Space|Camera")
+	float CameraBlendExp{2.0f};
+
+	/**
+	 * Returns the precomputed profile of the given movement space state.
+	 * @param State - The movement space state.
+	 * @return The profile of the state.
+	 */
+	static const FPLMovementSpaceProfile &Get(EPLMovementSpaceState State);
+
+	/**
+	 * Checks, whether the plane constraint settings of both profiles are equal.
+	 * @param Other - The profile to compare with.
+	 * @return True if switching between the profiles does not need a reconfiguration of the plane constraint; False otherwise.
+	 */
+	bool HasEqualPlaneConstraint(const FPLMovementSpaceProfile &Other) const;
+};
+
+/** A transition into a movement space state together with the spline and camera it needs, so that it can be applied at once (e.g. on spawn or by trigger volumes). */
+USTRUCT(BlueprintType)
+struct PROJECTLUX_API FPLMovementSpaceTransition
+{
+	GENERATED_BODY()
+
+	/** The movement space state to enter. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Movement Space")
+	EPLMovementSpaceState MovementSpace{EPLMovementSpaceState::MovementIn3D};
+
+	/** The spline to move on in the EPLMovementSpaceState::MovementOnSpline state. If nullptr, the current spline is kept. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Movement Space")
+	USplineComponent *MovementSpline{nullptr};
+
+	/** The camera to view through after the transition. If nullptr, the current view target is kept. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Movement Space")
+	ACameraActor *Camera{nullptr};
+
+	/** Whether the camera is switched at once instead of blending with the settings of the FPLMovementSpaceProfile (e.g. on a spawn). */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Movement Space")
+	bool bCutToCamera{false};
+
+	/**
+	 * Checks, whether both transitions lead to the same state with the same spline and camera.
+	 * @param Other - The transition to compare with.
+	 * @return True if the transitions are equal; False otherwise.
+	 */
+	bool operator==(const FPLMovementSpaceTransition &Other) const;
+};
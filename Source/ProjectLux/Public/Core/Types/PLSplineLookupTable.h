@@ -0,0 +1,162 @@
+// Copyright TinyAlmonds (Alex Noerdemann)
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "PLSplineLookupTable.generated.h"
+
+// Forward declarations
+class USplineComponent;
+
+/**
+ * Lookup table of a spline sampled in equal arc-length steps, which is baked in the editor (on save and cook) and serialized with the owning actor of the level.
+ * Every sample stores the location, the tangent direction and the yaw in the local space of the spline component in a quantized format (14 bytes per sample),
+ * so that the runtime queries only interpolate between two samples instead of evaluating or searching the spline.
+ */
+USTRUCT()
+struct PROJECTLUX_API FPLSplineLookupTable
+{
+	GENERATED_BODY()
+
+	/** Default distance between two samples along the spline [uu]. */
+	static constexpr float DefaultSampleSpacing{25.0f};
+
+	/**
+	 * Samples the given spline. Meant to be called in the editor (e.g. in PreSave()), since sampling a long spline is expensive.
+	 * @param Spline - The spline to sample.
+	 * @param MaxSampleSpacing - The maximum distance between two samples along the spline [uu].
+	 */
+	void Bake(const USplineComponent &Spline, float MaxSampleSpacing = DefaultSampleSpacing);
+
+	/** Removes the baked samples. */
+	void Reset();
+
+	/**
+	 * Checks, whether the table holds samples of the given spline in its current shape (number of points, loop and length).
+	 * @param Spline - The spline to check.
+	 * @return True if the table can be used for the spline; False if it is not baked or outdated.
+	 */
+	bool IsValidFor(const USplineComponent &Spline) const;
+
+	/**
+	 * Returns the length of the baked spline.
+	 * @return The length of the spline [uu].
+	 */
+	float GetSplineLength() const;
+
+	/**
+	 * Returns the world location at the given distance along the spline.
+	 * @param Distance - The distance along the spline [uu]. Clamped or wrapped (closed loop) to the spline.
+	 * @param SplineTransform - The world transform of the spline component.
+	 * @return The world location.
+	 */
+	FVector GetLocationAtDistance(float Distance, const FTransform &SplineTransform) const;
+
+	/**
+	 * Returns the world direction of the tangent at the given distance along the spline.
+	 * @param Distance - The distance along the spline [uu]. Clamped or wrapped (closed loop) to the spline.
+	 * @param SplineTransform - The world transform of the spline component.
+	 * @return The normalized world direction.
+	 */
+	FVector GetDirectionAtDistance(float Distance, const FTransform &SplineTransform) const;
+
+	/**
+	 * Returns the world yaw of the tangent at the given distance along the spline. Assumes that the spline component is only rotated around the Z-axis.
+	 * @param Distance - The distance along the spline [uu]. Clamped or wrapped (closed loop) to the spline.
+	 * @param SplineTransform - The world transform of the spline component.
+	 * @return The yaw [deg].
+	 */
+	float GetYawAtDistance(float Distance, const FTransform &SplineTransform) const;
+
+	/**
+	 * Returns the distance along the spline of the location closest to the given world location.
+	 * @param WorldLocation - The world location.
+	 * @param SplineTransform - The world transform of the spline component.
+	 * @return The distance along the spline [uu].
+	 */
+	float FindDistanceClosestToLocation(const FVector &WorldLocation, const FTransform &SplineTransform) const;
+
+	/**
+	 * Returns the distance along the spline of the location closest to the given world location, searching only around the given distance (e.g. the result of the previous frame).
+	 * Falls back to the search on the whole spline, if the closest location of the searched part lies on its border.
+	 * @param WorldLocation - The world location.
+	 * @param SplineTransform - The world transform of the spline component.
+	 * @param StartDistance - The distance along the spline around which is searched [uu].
+	 * @param SearchDistance - The distance along the spline searched in both directions [uu].
+	 * @return The distance along the spline [uu].
+	 */
+	float FindDistanceClosestToLocation(const FVector &WorldLocation, const FTransform &SplineTransform, float StartDistance, float SearchDistance) const;
+
+	/**
+	 * Returns the memory allocated by the samples (e.g. for the memory report).
+	 * @return The allocated size [bytes].
+	 */
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	/**
+	 * Searches the closest location to the given local location on the given segments between the samples. Segment indices wrap around on closed loops.
+	 * @param LocalLocation - The location in the local space of the spline component.
+	 * @param FirstSegment - The index of the first searched segment.
+	 * @param NumSegments - The number of searched segments.
+	 * @param OutClosestSegment - The number of the segment (relative to the FirstSegment) holding the closest location.
+	 * @return The distance along the spline of the closest location [uu].
+	 */
+	float FindDistanceClosestToLocalLocation(const FVector &LocalLocation, int32 FirstSegment, int32 NumSegments, int32 &OutClosestSegment) const;
+
+	/**
+	 * Returns the samples enclosing the given distance.
+	 * @param Distance - The distance along the spline [uu].
+	 * @param OutIndex - The index of the sample before the distance.
+	 * @param OutAlpha - The interpolation alpha to the next sample.
+	 */
+	void GetSampleInterval(float Distance, int32 &OutIndex, float &OutAlpha) const;
+
+	/** Returns the dequantized local location of the given sample. */
+	FVector GetSampleLocation(int32 SampleIndex) const;
+
+	/** Returns the dequantized local tangent direction of the given sample. */
+	FVector GetSampleDirection(int32 SampleIndex) const;
+
+	/** Returns the dequantized local yaw of the given sample [deg]. */
+	float GetSampleYaw(int32 SampleIndex) const;
+
+	/** Returns the number of samples. */
+	int32 GetNumSamples() const;
+
+	/** Length of the baked spline [uu]. */
+	UPROPERTY()
+	float SplineLength{0.0f};
+
+	/** Distance between two samples along the spline [uu]. */
+	UPROPERTY()
+	float SampleSpacing{0.0f};
+
+	/** Number of points of the baked spline, used to detect outdated tables. */
+	UPROPERTY()
+	int32 NumSplinePoints{0};
+
+	/** Whether the baked spline is a closed loop. */
+	UPROPERTY()
+	bool bClosedLoop{false};
+
+	/** Minimum of the local bounds of the samples, which is the origin of the quantized locations. */
+	UPROPERTY()
+	FVector LocationOrigin{FVector::ZeroVector};
+
+	/** Size of a quantization step of the locations per axis [uu]. */
+	UPROPERTY()
+	FVector LocationStep{FVector::ZeroVector};
+
+	/** Quantized local locations (three components per sample). */
+	UPROPERTY()
+	TArray<uint16> QuantizedLocations;
+
+	/** Quantized local tangent directions (three components per sample). */
+	UPROPERTY()
+	TArray<int16> QuantizedDirections;
+
+	/** Quantized local yaws (full circle mapped to the uint16 range). */
+	UPROPERTY()
+	TArray<uint16> QuantizedYaws;
+};